@@ -0,0 +1,609 @@
+// runtime microbenchmarks for the lookup and reflection functions
+// build it from the repository root with optimisations turned on, for example
+//   g++ -std=c++20 -O2 -I. benchmark/benchmark.cpp -o nested_enum_benchmark
+//   cl /std:c++20 /O2 /EHsc /Zc:preprocessor /I. benchmark\benchmark.cpp
+// or through the nested_enum_benchmark target of the CMakeLists.txt at the root
+// all enums are generated by the preprocessor and random inputs come from a fixed seed, so runs can be compared
+// every function is measured on hit (entries in declaration order), random (uniformly drawn entries) and miss inputs
+// the largest enums are 2048 entries, the most a single enum can have, those and the trees of depth 5 and 6 take
+// several minutes to compile, so they are only included when NESTED_ENUM_BENCHMARK_LARGE is defined
+// name lookups are also measured with every lookup strategy (linear, hash and decision tree) on their own
+// parse_bulk is measured on every power of 2 threads up to the number of hardware threads, to show how it scales
+// the mixed lookups interleave names, values and integers of several enums, on Linux they also report the cache misses
+// per operation through perf_event_open (which needs /proc/sys/kernel/perf_event_paranoid of 2 or lower)
+
+#include "nested_enum.hpp"
+#include "nested_enum_parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+// names are base 8 numbers appended to a prefix
+#define BENCHMARK_4(m, p) m(p##0) m(p##1) m(p##2) m(p##3)
+#define BENCHMARK_8(m, p) m(p##0) m(p##1) m(p##2) m(p##3) m(p##4) m(p##5) m(p##6) m(p##7)
+#define BENCHMARK_64(m, p) BENCHMARK_8(m, p##0) BENCHMARK_8(m, p##1) BENCHMARK_8(m, p##2) BENCHMARK_8(m, p##3) \
+  BENCHMARK_8(m, p##4) BENCHMARK_8(m, p##5) BENCHMARK_8(m, p##6) BENCHMARK_8(m, p##7)
+#define BENCHMARK_512(m, p) BENCHMARK_64(m, p##0) BENCHMARK_64(m, p##1) BENCHMARK_64(m, p##2) BENCHMARK_64(m, p##3) \
+  BENCHMARK_64(m, p##4) BENCHMARK_64(m, p##5) BENCHMARK_64(m, p##6) BENCHMARK_64(m, p##7)
+#define BENCHMARK_2048(m, p) BENCHMARK_512(m, p##0) BENCHMARK_512(m, p##1) BENCHMARK_512(m, p##2) BENCHMARK_512(m, p##3)
+
+// trailing commas are fine, empty entries are skipped
+#define BENCHMARK_ENTRY(name) name,
+#define BENCHMARK_ENTRY_WITH_ID(name) (name, ID, #name),
+
+// flat enums, up to the 2048 entries a single enum can hold
+NESTED_ENUM((Flat4), (BENCHMARK_4(BENCHMARK_ENTRY, v)))
+NESTED_ENUM((Flat64), (BENCHMARK_64(BENCHMARK_ENTRY, v)))
+NESTED_ENUM((Flat512), (BENCHMARK_512(BENCHMARK_ENTRY, v)))
+#ifdef NESTED_ENUM_BENCHMARK_LARGE
+NESTED_ENUM((Flat2048), (BENCHMARK_2048(BENCHMARK_ENTRY, v)))
+#endif
+
+// values spread over [0, 1000], checked against a bitmap instead of a range
+NESTED_ENUM((Sparse8), ((s0, VAL, 0), (s1, VAL, 7), (s2, VAL, 64), (s3, VAL, 100), (s4, VAL, 333), (s5, VAL, 512),
+  (s6, VAL, 801), (s7, VAL, 1000)))
+
+// trees where every inner node has 4 children, from 4 entries at depth 1 up to 5460 entries at depth 6
+#define BENCHMARK_CHILDREN(n) (BENCHMARK_ENTRY_WITH_ID(n##_0) BENCHMARK_ENTRY_WITH_ID(n##_1) \
+  BENCHMARK_ENTRY_WITH_ID(n##_2) BENCHMARK_ENTRY_WITH_ID(n##_3))
+#define BENCHMARK_TREE1(n) BENCHMARK_CHILDREN(n)
+#define BENCHMARK_TREE2(n) BENCHMARK_CHILDREN(n), (ENUM, n##_0, BENCHMARK_TREE1(n##_0)), (ENUM, n##_1, BENCHMARK_TREE1(n##_1)), \
+  (ENUM, n##_2, BENCHMARK_TREE1(n##_2)), (ENUM, n##_3, BENCHMARK_TREE1(n##_3))
+#define BENCHMARK_TREE3(n) BENCHMARK_CHILDREN(n), (ENUM, n##_0, BENCHMARK_TREE2(n##_0)), (ENUM, n##_1, BENCHMARK_TREE2(n##_1)), \
+  (ENUM, n##_2, BENCHMARK_TREE2(n##_2)), (ENUM, n##_3, BENCHMARK_TREE2(n##_3))
+#define BENCHMARK_TREE4(n) BENCHMARK_CHILDREN(n), (ENUM, n##_0, BENCHMARK_TREE3(n##_0)), (ENUM, n##_1, BENCHMARK_TREE3(n##_1)), \
+  (ENUM, n##_2, BENCHMARK_TREE3(n##_2)), (ENUM, n##_3, BENCHMARK_TREE3(n##_3))
+#define BENCHMARK_TREE5(n) BENCHMARK_CHILDREN(n), (ENUM, n##_0, BENCHMARK_TREE4(n##_0)), (ENUM, n##_1, BENCHMARK_TREE4(n##_1)), \
+  (ENUM, n##_2, BENCHMARK_TREE4(n##_2)), (ENUM, n##_3, BENCHMARK_TREE4(n##_3))
+#define BENCHMARK_TREE6(n) BENCHMARK_CHILDREN(n), (ENUM, n##_0, BENCHMARK_TREE5(n##_0)), (ENUM, n##_1, BENCHMARK_TREE5(n##_1)), \
+  (ENUM, n##_2, BENCHMARK_TREE5(n##_2)), (ENUM, n##_3, BENCHMARK_TREE5(n##_3))
+
+NESTED_ENUM((Tree1), BENCHMARK_TREE1(t))
+NESTED_ENUM((Tree2), BENCHMARK_TREE2(t))
+NESTED_ENUM((Tree3), BENCHMARK_TREE3(t))
+NESTED_ENUM((Tree4), BENCHMARK_TREE4(t))
+#ifdef NESTED_ENUM_BENCHMARK_LARGE
+NESTED_ENUM((Tree5), BENCHMARK_TREE5(t))
+NESTED_ENUM((Tree6), BENCHMARK_TREE6(t))
+#endif
+
+// hand-written baselines, what the same lookups look like without the library
+#define BENCHMARK_CASE_NAME(name) case Enum::name: return #name;
+#define BENCHMARK_CASE_VALUE(name) case Enum::name: return Enum{ Enum::name };
+#define BENCHMARK_IF_NAME(name) if (string == #name) return Enum{ Enum::name };
+
+#define BENCHMARK_DEFINE_BASELINE(type, list)                           \
+  struct baseline_##type                                                \
+  {                                                                     \
+    using Enum = type;                                                  \
+                                                                        \
+    static std::string_view name(Enum value)                            \
+    {                                                                   \
+      switch (value)                                                    \
+      {                                                                 \
+        list(BENCHMARK_CASE_NAME, v)                                    \
+      }                                                                 \
+      return {};                                                        \
+    }                                                                   \
+                                                                        \
+    static std::optional<Enum> value(Enum::underlying_type integer)     \
+    {                                                                   \
+      switch (integer)                                                  \
+      {                                                                 \
+        list(BENCHMARK_CASE_VALUE, v)                                   \
+      }                                                                 \
+      return {};                                                        \
+    }                                                                   \
+                                                                        \
+    static std::optional<Enum> value(std::string_view string)           \
+    {                                                                   \
+      list(BENCHMARK_IF_NAME, v)                                        \
+      return {};                                                        \
+    }                                                                   \
+  };
+
+BENCHMARK_DEFINE_BASELINE(Flat4, BENCHMARK_4)
+BENCHMARK_DEFINE_BASELINE(Flat64, BENCHMARK_64)
+BENCHMARK_DEFINE_BASELINE(Flat512, BENCHMARK_512)
+#ifdef NESTED_ENUM_BENCHMARK_LARGE
+BENCHMARK_DEFINE_BASELINE(Flat2048, BENCHMARK_2048)
+#endif
+
+namespace
+{
+  constexpr std::uint32_t seed = 0x6e657374;
+  constexpr std::size_t randomInputs = 1024;
+  constexpr auto minimumTime = std::chrono::milliseconds(50);
+
+  volatile std::size_t sink = 0;
+
+  // repeats the inputs until minimumTime has passed and prints the time per operation
+  template<typename T, typename Function>
+  void run(const char *function, std::size_t entries, const char *pattern, const std::vector<T> &inputs, Function &&call)
+  {
+    using clock = std::chrono::steady_clock;
+
+    // small input sets are repeated between clock reads so reading the clock doesn't dominate
+    std::size_t repeats = std::max<std::size_t>(1, randomInputs / inputs.size());
+    std::size_t checksum = 0;
+    std::size_t operations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration{};
+    do
+    {
+      for (std::size_t i = 0; i < repeats; ++i)
+        for (const auto &input : inputs)
+          checksum += call(input);
+      operations += repeats * inputs.size();
+      elapsed = clock::now() - start;
+    } while (elapsed < minimumTime);
+
+    sink = sink + checksum;
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (double)operations;
+    std::printf("%-40s %6zu  %-6s %12.2f ns/op %12.2f Mop/s\n", function, entries, pattern, nanoseconds, 1e3 / nanoseconds);
+  }
+
+  // counts the cache misses of the calling thread in user space, if the system lets it
+  class cache_miss_counter
+  {
+  public:
+    cache_miss_counter()
+    {
+    #ifdef __linux__
+      perf_event_attr attributes{};
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.size = sizeof(attributes);
+      attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+      attributes.disabled = 1;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      descriptor = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    #endif
+    }
+    cache_miss_counter(const cache_miss_counter &) = delete;
+    cache_miss_counter &operator=(const cache_miss_counter &) = delete;
+    ~cache_miss_counter()
+    {
+    #ifdef __linux__
+      if (descriptor >= 0)
+        close(descriptor);
+    #endif
+    }
+
+    void start()
+    {
+    #ifdef __linux__
+      if (descriptor >= 0)
+      {
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    #endif
+    }
+    std::optional<std::uint64_t> stop()
+    {
+    #ifdef __linux__
+      std::uint64_t count = 0;
+      if (descriptor >= 0 && ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0) == 0 && read(descriptor, &count, sizeof(count)) == sizeof(count))
+        return count;
+    #endif
+      return {};
+    }
+
+  private:
+    int descriptor = -1;
+  };
+
+  // hit, random and miss inputs drawn from the same list
+  template<typename T>
+  struct input_set
+  {
+    std::vector<T> hit;
+    std::vector<T> random;
+    std::vector<T> miss;
+  };
+
+  template<typename T>
+  auto make_inputs(std::vector<T> hit, std::vector<T> miss)
+  {
+    std::mt19937 generator{ seed };
+    std::vector<T> random;
+    random.reserve(randomInputs);
+    for (std::size_t i = 0; i < randomInputs; ++i)
+      random.push_back(hit[generator() % hit.size()]);
+
+    return input_set<T>{ std::move(hit), std::move(random), std::move(miss) };
+  }
+
+  // same length and prefix as the real string, so the comparisons can't exit early
+  std::string make_miss(std::string_view string)
+  {
+    std::string miss{ string };
+    miss.back() = '#';
+    return miss;
+  }
+
+  template<typename T, typename Function>
+  void run_all(const char *function, std::size_t entries, const input_set<T> &inputs, Function &&call)
+  {
+    run(function, entries, "hit", inputs.hit, call);
+    run(function, entries, "random", inputs.random, call);
+    run(function, entries, "miss", inputs.miss, call);
+  }
+
+  // the same name lookup with every strategy, enum_value(std::string_view) uses nested_enum::enum_lookup_strategy<E>
+  template<typename E>
+  void run_strategies(std::size_t entries, const input_set<std::string> &inputs)
+  {
+    using nested_enum::lookup_strategy;
+    run_all("name lookup: linear", entries, inputs,
+      [](const std::string &name) { return nested_enum::detail::find_string<E, false, lookup_strategy::linear>(name); });
+    run_all("name lookup: hash", entries, inputs,
+      [](const std::string &name) { return nested_enum::detail::find_string<E, false, lookup_strategy::hash>(name); });
+    run_all("name lookup: decision_tree", entries, inputs,
+      [](const std::string &name) { return nested_enum::detail::find_string<E, false, lookup_strategy::decision_tree>(name); });
+  }
+
+  template<typename E, typename Baseline>
+  void run_flat()
+  {
+    constexpr std::size_t entries = E::enum_count();
+
+    std::vector<std::string> names, cleanNames, missNames, missCleanNames;
+    for (auto name : E::enum_names())
+    {
+      names.emplace_back(name);
+      missNames.push_back(make_miss(name));
+    }
+    for (auto name : E::enum_names(true))
+    {
+      cleanNames.emplace_back(name);
+      missCleanNames.push_back(make_miss(name));
+    }
+
+    std::vector<E> values{ E::enumValues.begin(), E::enumValues.end() };
+
+    std::vector<typename E::underlying_type> integers, missIntegers;
+    for (auto value : E::enumValues)
+    {
+      integers.push_back((typename E::underlying_type)value);
+      missIntegers.push_back((typename E::underlying_type)(value + entries));
+    }
+
+    auto nameInputs = make_inputs(std::move(names), std::move(missNames));
+    auto cleanNameInputs = make_inputs(std::move(cleanNames), std::move(missCleanNames));
+    auto integerInputs = make_inputs(std::move(integers), std::move(missIntegers));
+    auto valueInputs = make_inputs(values, values);
+
+    run_all("enum_value(std::string_view)", entries, nameInputs,
+      [](const std::string &name) { auto value = E::enum_value(name); return value ? (std::size_t)value->enum_integer() + 1 : 0; });
+    run_all("baseline: if chain on names", entries, cleanNameInputs,
+      [](const std::string &name) { auto value = Baseline::value(std::string_view(name)); return value ? (std::size_t)value->enum_integer() + 1 : 0; });
+    run_strategies<E>(entries, nameInputs);
+
+    // every value exists, so there are no misses for this one
+    run("enum_name(E)", entries, "hit", valueInputs.hit, [](E value) { return E::enum_name(value, true)->size(); });
+    run("enum_name(E)", entries, "random", valueInputs.random, [](E value) { return E::enum_name(value, true)->size(); });
+    run("baseline: switch to name", entries, "hit", valueInputs.hit, [](E value) { return Baseline::name(value).size(); });
+    run("baseline: switch to name", entries, "random", valueInputs.random, [](E value) { return Baseline::name(value).size(); });
+
+    run_all("make_enum(integer)", entries, integerInputs,
+      [](typename E::underlying_type integer) { auto value = E::make_enum(integer); return value ? (std::size_t)value->enum_integer() + 1 : 0; });
+    run_all("baseline: switch to value", entries, integerInputs,
+      [](typename E::underlying_type integer) { auto value = Baseline::value(integer); return value ? (std::size_t)value->enum_integer() + 1 : 0; });
+
+    std::printf("\n");
+  }
+
+  template<typename E>
+  void run_tree(std::size_t depth)
+  {
+    constexpr std::size_t entries = E::enum_count_recursive();
+
+    std::vector<std::string> names, missNames, ids, missIds;
+    for (auto name : E::template enum_names_recursive<nested_enum::All>())
+    {
+      names.emplace_back(name);
+      missNames.push_back(make_miss(name));
+    }
+    for (auto id : E::template enum_ids_recursive<nested_enum::All>())
+    {
+      ids.emplace_back(id.value());
+      missIds.push_back(make_miss(id.value()));
+    }
+
+    auto nameInputs = make_inputs(std::move(names), std::move(missNames));
+    auto idInputs = make_inputs(std::move(ids), std::move(missIds));
+
+    char function[64];
+    std::snprintf(function, sizeof(function), "enum_id_recursive (depth %zu)", depth);
+    run_all(function, entries, nameInputs, [](const std::string &name) { return E::enum_id_recursive(name).value_or("").size(); });
+
+    std::snprintf(function, sizeof(function), "enum_name_by_id_recursive (depth %zu)", depth);
+    run_all(function, entries, idInputs, [](const std::string &id) { return E::enum_name_by_id_recursive(id).value_or("").size(); });
+
+    std::printf("\n");
+  }
+
+  // random mix of name to value, value to name and integer to value lookups spread over several enums,
+  // closer to a real workload than the loops above since the tables of one enum get evicted by the others
+  template<typename ... Es>
+  void run_mixed()
+  {
+    constexpr std::size_t operations = 1 << 20;
+    constexpr std::size_t entries = (Es::enum_count() + ...);
+
+    // every operation is a lookup function and its input, both chosen at random
+    std::mt19937 generator{ seed };
+    std::vector<std::string> names;
+    std::vector<std::size_t (*)(const std::string &, std::size_t)> lookups;
+    std::vector<std::size_t> indices;
+    names.reserve(operations);
+    lookups.reserve(operations);
+    indices.reserve(operations);
+
+    auto add = [&]<typename E>(std::type_identity<E>)
+    {
+      std::size_t index = generator() % E::enum_count();
+      indices.push_back(index);
+      names.emplace_back(E::enum_names()[index]);
+      switch (generator() % 3)
+      {
+      case 0:
+        lookups.push_back([](const std::string &name, std::size_t) { auto value = E::enum_value(name); return value ? (std::size_t)value->enum_integer() + 1 : 0; });
+        break;
+      case 1:
+        lookups.push_back([](const std::string &, std::size_t index) { return E::enum_name(E{ E::enumValues[index] }, true)->size(); });
+        break;
+      default:
+        lookups.push_back([](const std::string &, std::size_t index) { auto value = E::make_enum((typename E::underlying_type)E::enumValues[index]); return value ? (std::size_t)value->enum_integer() + 1 : 0; });
+        break;
+      }
+    };
+    using adder = void (*)(decltype(add) &);
+    constexpr adder adders[] = { [](decltype(add) &function) { function(std::type_identity<Es>{}); }... };
+    for (std::size_t i = 0; i < operations; ++i)
+      adders[generator() % sizeof...(Es)](add);
+
+    cache_miss_counter counter;
+    using clock = std::chrono::steady_clock;
+    std::size_t checksum = 0;
+    counter.start();
+    auto start = clock::now();
+    for (std::size_t i = 0; i < operations; ++i)
+      checksum += lookups[i](names[i], indices[i]);
+    auto elapsed = clock::now() - start;
+    auto misses = counter.stop();
+    sink = sink + checksum;
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (double)operations;
+    std::printf("%-40s %6zu  %-6s %12.2f ns/op %12.2f Mop/s", "mixed lookups", entries, "random", nanoseconds, 1e3 / nanoseconds);
+    if (misses.has_value())
+      std::printf(" %12.3f misses/op\n\n", (double)misses.value() / (double)operations);
+    else
+      std::printf("   cache misses unavailable\n\n");
+  }
+
+  template<typename E>
+  void run_parse_bulk()
+  {
+    constexpr std::size_t entries = E::enum_count();
+    constexpr std::size_t tokens = 1 << 22;
+
+    // every 16th token is a miss
+    std::mt19937 generator{ seed };
+    std::vector<std::string> strings;
+    strings.reserve(tokens);
+    for (std::size_t i = 0; i < tokens; ++i)
+    {
+      std::string_view name = E::enum_names()[generator() % entries];
+      strings.push_back((i % 16 == 15) ? make_miss(name) : std::string{ name });
+    }
+    std::vector<std::string_view> input{ strings.begin(), strings.end() };
+
+    std::vector<typename E::Value> output(tokens);
+    std::vector<std::uint64_t> errors((tokens + 63) / 64);
+
+    auto measure = [&](const char *function, auto &&call)
+    {
+      using clock = std::chrono::steady_clock;
+
+      std::size_t passes = 0;
+      auto start = clock::now();
+      auto elapsed = clock::duration{};
+      do
+      {
+        sink = sink + call();
+        ++passes;
+        elapsed = clock::now() - start;
+      } while (elapsed < minimumTime * 4);
+
+      double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (double)(passes * tokens);
+      std::printf("%-40s %6zu  %-6s %12.2f ns/op %12.2f Mop/s\n", function, entries, "random", nanoseconds, 1e3 / nanoseconds);
+    };
+
+    measure("enum_value(std::string_view) loop", [&]()
+      {
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < tokens; ++i)
+        {
+          auto value = E::enum_value(input[i]);
+          if (value.has_value())
+            output[i] = value.value();
+          else
+            ++failed;
+        }
+        return failed;
+      });
+
+    // powers of 2 and the number of hardware threads itself
+    std::size_t hardwareThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::size_t> threadCounts;
+    for (std::size_t threads = 1; threads < hardwareThreads; threads *= 2)
+      threadCounts.push_back(threads);
+    threadCounts.push_back(hardwareThreads);
+
+    char function[64];
+    for (std::size_t threads : threadCounts)
+    {
+      std::snprintf(function, sizeof(function), "parse_bulk (%zu threads)", threads);
+      measure(function, [&]() { return nested_enum::parse_bulk<E>(input, output, errors, threads).value(); });
+    }
+
+    std::printf("\n");
+  }
+
+  template<typename E>
+  void run_validate()
+  {
+    using underlying_type = typename E::underlying_type;
+    constexpr std::size_t entries = E::enum_count();
+    constexpr std::size_t integers = 1 << 22;
+
+    // every 16th integer is one past the largest value
+    std::mt19937 generator{ seed };
+    std::vector<underlying_type> input;
+    input.reserve(integers);
+    for (std::size_t i = 0; i < integers; ++i)
+      input.push_back((i % 16 == 15) ? nested_enum::enum_traits<E>::max_value + 1 : (underlying_type)E::enumValues[generator() % entries]);
+
+    std::vector<typename E::Value> output(integers);
+    std::vector<std::uint64_t> invalid((integers + 63) / 64);
+
+    auto measure = [&](const char *function, auto &&call)
+    {
+      using clock = std::chrono::steady_clock;
+
+      std::size_t passes = 0;
+      auto start = clock::now();
+      auto elapsed = clock::duration{};
+      do
+      {
+        sink = sink + call();
+        ++passes;
+        elapsed = clock::now() - start;
+      } while (elapsed < minimumTime * 4);
+
+      double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (double)(passes * integers);
+      std::printf("%-40s %6zu  %-6s %12.2f ns/op %12.2f Mop/s\n", function, entries, "random", nanoseconds, 1e3 / nanoseconds);
+    };
+
+    measure("enum_value(integer) loop", [&]()
+      {
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < integers; ++i)
+        {
+          auto value = E::enum_value(input[i]);
+          if (value.has_value())
+            output[i] = value.value();
+          else
+            ++failed;
+        }
+        return failed;
+      });
+    measure("validate", [&]() { return nested_enum::validate<E>(input, invalid).value(); });
+    measure("convert", [&]() { return nested_enum::convert<E>(input, output, invalid).value(); });
+
+    std::printf("\n");
+  }
+
+  template<typename E>
+  void run_sampler()
+  {
+    constexpr std::size_t entries = E::enum_count();
+    constexpr std::size_t draws = 1 << 20;
+
+    // the weight of a value grows with its position
+    std::vector<double> weights(entries), cumulative(entries);
+    double total = 0;
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+      weights[i] = (double)(i + 1);
+      total += weights[i];
+      cumulative[i] = total;
+    }
+    auto sampler = nested_enum::alias_sampler<E>::make(weights).value();
+
+    std::mt19937_64 generator{ seed };
+    auto measure = [&](const char *function, auto &&draw)
+    {
+      using clock = std::chrono::steady_clock;
+
+      std::size_t passes = 0;
+      auto start = clock::now();
+      auto elapsed = clock::duration{};
+      do
+      {
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < draws; ++i)
+          checksum += (std::size_t)draw().enum_integer();
+        sink = sink + checksum;
+        ++passes;
+        elapsed = clock::now() - start;
+      } while (elapsed < minimumTime * 4);
+
+      double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (double)(passes * draws);
+      std::printf("%-40s %6zu  %-6s %12.2f ns/op %12.2f Mop/s\n", function, entries, "random", nanoseconds, 1e3 / nanoseconds);
+    };
+
+    measure("cumulative weight scan", [&]()
+      {
+        double target = std::uniform_real_distribution<double>(0, total)(generator);
+        std::size_t i = 0;
+        while (i + 1 < entries && cumulative[i] <= target)
+          ++i;
+        return E{ E::enumValues[i] };
+      });
+    measure("alias_sampler", [&]() { return sampler(generator); });
+
+    std::printf("\n");
+  }
+}
+
+int main()
+{
+  std::printf("%-40s %6s  %-6s %18s %18s\n\n", "function", "size", "inputs", "time", "throughput");
+
+  run_flat<Flat4, baseline_Flat4>();
+  run_flat<Flat64, baseline_Flat64>();
+  run_flat<Flat512, baseline_Flat512>();
+#ifdef NESTED_ENUM_BENCHMARK_LARGE
+  run_flat<Flat2048, baseline_Flat2048>();
+#endif
+
+  run_tree<Tree1>(1);
+  run_tree<Tree2>(2);
+  run_tree<Tree3>(3);
+  run_tree<Tree4>(4);
+#ifdef NESTED_ENUM_BENCHMARK_LARGE
+  run_tree<Tree5>(5);
+  run_tree<Tree6>(6);
+#endif
+
+  run_mixed<Flat4, Flat64, Flat512>();
+
+  run_parse_bulk<Flat64>();
+  run_parse_bulk<Flat512>();
+
+  run_validate<Flat64>();
+  run_validate<Sparse8>();
+
+  run_sampler<Flat4>();
+  run_sampler<Flat64>();
+  run_sampler<Flat512>();
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+# measures the compile time of the recursive queries on generated trees, every node has `branches` children and the
+# tree has `depth` levels of them, each tree is compiled in its own file that calls every recursive query on the root
+#
+#   python3 benchmark/compile_time.py                       # the default trees 3x4 4x4 2x6 2x8
+#   python3 benchmark/compile_time.py 2x6 3x5 --cxx clang++ # branches x depth
+#   python3 benchmark/compile_time.py 2x4 --print           # only print the generated source
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def node(name, level, branches, depth):
+  children = [f'{name}_{i}' for i in range(branches)]
+  if level == depth:
+    return f'(ENUM, {name}, ({", ".join(children)}))'
+  nested = ', '.join(node(child, level + 1, branches, depth) for child in children)
+  return f'(ENUM, {name}, ({", ".join(children)}), {nested})'
+
+
+def generate(branches, depth):
+  children = [f'N_{i}' for i in range(branches)]
+  nested = ', '.join(node(child, 2, branches, depth) for child in children)
+  return '\n'.join([
+    '#include "nested_enum.hpp"',
+    f'NESTED_ENUM((Tree, std::int32_t), ({", ".join(children)}), {nested})',
+    'constexpr auto names = Tree::enum_names_recursive<nested_enum::All>();',
+    'constexpr auto shortNames = Tree::enum_names_recursive<nested_enum::Outer, true, true>();',
+    'constexpr auto ids = Tree::enum_ids_recursive<nested_enum::Inner>();',
+    'constexpr auto namesAndIds = Tree::enum_names_and_ids_recursive<nested_enum::All>();',
+    'constexpr auto values = Tree::enum_values_recursive<nested_enum::All>();',
+    'constexpr auto subtree = Tree::N_0::enum_names_recursive<nested_enum::All, false>();',
+    'static_assert(names.size() == Tree::enum_count_recursive());',
+    'static_assert(shortNames.size() == Tree::enum_count_recursive(nested_enum::Outer));',
+    'int main() { }',
+    ''])
+
+
+def tree(text):
+  branches, depth = text.lower().split('x')
+  return int(branches), int(depth)
+
+
+def main():
+  parser = argparse.ArgumentParser(description='compile time of the recursive queries on generated trees')
+  parser.add_argument('trees', nargs='*', type=tree, default=[(3, 4), (4, 4), (2, 6), (2, 8)],
+                      help='trees as <branches>x<depth>')
+  parser.add_argument('--cxx', default=os.environ.get('CXX', 'g++'), help='compiler, $CXX or g++ by default')
+  parser.add_argument('--flags', default='-std=c++20', help='compiler flags')
+  parser.add_argument('--timeout', type=float, default=600, help='seconds before a compile is given up')
+  parser.add_argument('--print', action='store_true', help='print the generated source instead of compiling it')
+  args = parser.parse_args()
+
+  if args.print:
+    for branches, depth in args.trees:
+      sys.stdout.write(generate(branches, depth))
+    return
+
+  print(f'{"tree":>8} {"nodes":>8} {"seconds":>8}')
+  with tempfile.TemporaryDirectory() as directory:
+    for branches, depth in args.trees:
+      source = os.path.join(directory, f'tree_{branches}x{depth}.cpp')
+      with open(source, 'w') as file:
+        file.write(generate(branches, depth))
+      nodes = sum(branches ** level for level in range(depth))
+      command = [args.cxx, *args.flags.split(), f'-I{root}', '-fsyntax-only', source]
+      start = time.perf_counter()
+      try:
+        result = subprocess.run(command, capture_output=True, text=True, timeout=args.timeout)
+      except subprocess.TimeoutExpired:
+        print(f'{branches:>4}x{depth:<3} {nodes:>8} {">" + str(int(args.timeout)):>8}')
+        continue
+      seconds = time.perf_counter() - start
+      if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        sys.exit(f'{branches}x{depth} failed to compile')
+      print(f'{branches:>4}x{depth:<3} {nodes:>8} {seconds:>8.1f}')
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,45 @@
+// module interface unit for nested_enum, exports nested_enum_parallel.hpp as well
+// experimental and untested beyond g++ 12, which crashes on modules that define trees (see README)
+// macros can't be exported from a module, so a module that defines enum trees still includes
+// nested_enum.hpp in its global module fragment with NESTED_ENUM_MACROS_ONLY defined (see README)
+module;
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <array>
+#include <string_view>
+#include <optional>
+#include <tuple>
+#include <bit>
+#include <span>
+#include <variant>
+#include <compare>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <initializer_list>
+#include <limits>
+#include <iosfwd>
+#include <version>
+#ifdef __cpp_lib_format
+  #include <format>
+#endif
+
+export module nested_enum;
+
+// the detail namespace is exported as well because the code generated by the macros refers to it
+#define NESTED_ENUM_NO_STD_SPECIALIZATIONS
+export
+{
+#include "nested_enum.hpp"
+#include "nested_enum_parallel.hpp"
+}
+#undef NESTED_ENUM_NO_STD_SPECIALIZATIONS
+
+// g++ 12 rejects the std::hash and std::formatter specializations inside a named module ("cannot declare in a
+// different module"), importers that need them include the header with NESTED_ENUM_STD_SPECIALIZATIONS_ONLY
@@ -12,6 +12,22 @@
 #include <string_view>
 #include <optional>
 #include <tuple>
+#include <bit>
+#include <span>
+#include <variant>
+#include <compare>
+#include <functional>
+#include <vector>
+#include <initializer_list>
+#include <limits>
+#include <iosfwd>
+#include <version>
+#ifdef __cpp_lib_format
+  #include <format>
+#endif
+#ifdef NESTED_ENUM_INSTRUMENTATION
+  #include <atomic>
+#endif
 
 #ifndef NESTED_ENUM_DEFAULT_ENUM_TYPE
   #define NESTED_ENUM_DEFAULT_ENUM_TYPE ::std::int32_t
@@ -21,6 +37,31 @@
   #define NESTED_ENUM_SUPPRESS_MULTIPLE_RESULTS_ASSERT 0
 #endif
 
+// defining NESTED_ENUM_NO_NAMES and/or NESTED_ENUM_NO_IDS leaves the reflected strings and/or ids out of every enum
+// and removes the functions that need them, everything numeric and type based keeps working
+#ifdef NESTED_ENUM_NO_NAMES
+  #define NESTED_ENUM_INTERNAL_IF_NAMES(...)
+#else
+  #define NESTED_ENUM_INTERNAL_IF_NAMES(...) __VA_ARGS__
+#endif
+
+#ifdef NESTED_ENUM_NO_IDS
+  #define NESTED_ENUM_INTERNAL_IF_IDS(...)
+#else
+  #define NESTED_ENUM_INTERNAL_IF_IDS(...) __VA_ARGS__
+#endif
+
+// defining NESTED_ENUM_INSTRUMENTATION counts the runtime lookups of every enum on thread local counters
+// (see for_each_lookup_counter), without it the hooks and their arguments compile to nothing
+#ifdef NESTED_ENUM_INSTRUMENTATION
+  #define NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, api, found, scanned) ::nested_enum::detail::count_lookup<E>(::nested_enum::lookup_api::api, found, scanned)
+#else
+  #define NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, api, found, scanned) ((void)0)
+#endif
+
+// when the declarations are imported from the nested_enum module only the macros are needed (see nested_enum.cppm)
+#if !defined(NESTED_ENUM_MACROS_ONLY) && !defined(NESTED_ENUM_STD_SPECIALIZATIONS_ONLY)
+
 namespace nested_enum
 {
   template <std::size_t N>
@@ -106,11 +147,27 @@ namespace nested_enum
     template<typename T, typename ... Ts>
     T get_first_type(type_list<T, Ts...>) { return T{}; }
 
+    template<std::size_t I, typename ... Ts>
+    auto get_type_at(type_list<Ts...>) { return std::type_identity<std::tuple_element_t<I, std::tuple<Ts...>>>{}; }
+
     template<typename T = int>
     struct opt { bool isInitialised = false; T value = 0; };
 
     inline constexpr fixed_string scopeResolution = "::";
 
+    // templated so that constraining the string functions with them doesn't get checked before instantiation
+  #ifdef NESTED_ENUM_NO_NAMES
+    template<typename E> inline constexpr bool hasNames = false;
+  #else
+    template<typename E> inline constexpr bool hasNames = true;
+  #endif
+
+  #ifdef NESTED_ENUM_NO_IDS
+    template<typename E> inline constexpr bool hasIds = false;
+  #else
+    template<typename E> inline constexpr bool hasIds = true;
+  #endif
+
     template<typename T>
     constexpr auto find_index(const auto &container, const T &value)
     {
@@ -135,133 +192,569 @@ namespace nested_enum
       return std::optional<std::size_t>{};
     }
 
-    template<typename E, typename T, opt<T> ... values>
-    consteval auto get_array_of_values()
+    // values of an enum sorted by their integers, with their positions in the enum kept in a separate array
+    // so that the binary search only touches the values, positions fit in 16 bits because of the 2048 entry limit
+    template<typename Value, std::size_t N>
+    struct sorted_values
     {
-      std::array<E, sizeof...(values)> enumValues{};
-      std::size_t index = 0;
-      T previous = 0;
+      alignas(64) std::array<Value, N> values{};
+      std::array<std::uint16_t, N> positions{};
+    };
 
-      for (auto current : std::initializer_list<opt<T>>{ values... })
+    template<typename E>
+    inline constexpr auto sortedValues = []()
+    {
+      sorted_values<typename E::Value, E::enumValues.size()> result{};
+      for (std::size_t i = 0; i < E::enumValues.size(); ++i)
       {
-        if (current.isInitialised)
-          previous = current.value;
-        
-        enumValues[index++] = (E)(previous++);
+        std::size_t j = i;
+        for (; j > 0 && E::enumValues[i] < result.values[j - 1]; --j)
+        {
+          result.values[j] = result.values[j - 1];
+          result.positions[j] = result.positions[j - 1];
+        }
+        result.values[j] = E::enumValues[i];
+        result.positions[j] = (std::uint16_t)i;
       }
+      return result;
+    }();
+
+    // values that weren't given a custom value are their own position
+    template<typename E>
+    inline constexpr bool isDense = []()
+    {
+      for (std::size_t i = 0; i < E::enumValues.size(); ++i)
+        if ((std::size_t)E::enumValues[i] != i)
+          return false;
+      return true;
+    }();
+
+    // position of a value in the declaration order of its enum, or the number of values if it isn't one of them
+    template<typename E>
+    constexpr std::size_t get_position(typename E::Value value) noexcept
+    {
+      if constexpr (isDense<E>)
+        return ((std::size_t)value < E::enumValues.size()) ? (std::size_t)value : E::enumValues.size();
+      else
+      {
+        constexpr auto &sorted = sortedValues<E>;
+        std::size_t first = 0, last = sorted.values.size();
+        while (first < last)
+        {
+          std::size_t middle = first + (last - first) / 2;
+          if (sorted.values[middle] < value)
+            first = middle + 1;
+          else
+            last = middle;
+        }
 
-      return enumValues;
+        return (first < sorted.values.size() && sorted.values[first] == value) ? sorted.positions[first] : sorted.values.size();
+      }
     }
 
-    template<fixed_string type, fixed_string value, fixed_string ... values>
-    consteval auto get_string_values()
+    // key that orders the values of an enum the way they are declared, which is also their order in the preorder of the tree
+    // enums declared in ascending order (like all default numbered ones) are ordered by the integers themselves
+    template<typename E>
+    constexpr auto get_ordering_key(typename E::Value value) noexcept
     {
-      static_assert(type.size() > 0);
-      constexpr auto current = type.append(scopeResolution.append(value));
+      constexpr bool isAscending = []()
+      {
+        for (std::size_t i = 1; i < E::enumValues.size(); ++i)
+          if (!(E::enumValues[i - 1] < E::enumValues[i]))
+            return false;
+        return true;
+      }();
 
-      if constexpr (sizeof...(values) == 0)
-        return current.append_full(fixed_string{ "" });
+      if constexpr (isAscending)
+        return (typename E::underlying_type)value;
       else
-        return current.append_full(get_string_values<type, values...>());
+        return get_position<E>(value);
     }
 
-    // bless their soul https://stackoverflow.com/a/54932626
-    namespace tuple_magic
+    // stable counting sort of input into output by key(element), which needs to be less than Buckets
+    // returns where every bucket starts in output followed by the number of elements, or nothing if output is too small
+    template<std::size_t Buckets, typename T>
+    constexpr auto bucket_sort(const auto &input, std::span<T> output, const auto &key) -> std::optional<std::array<std::size_t, Buckets + 1>>
     {
-      template <typename T> struct is_tuple : std::false_type { };
-      template <typename... Ts> struct is_tuple<std::tuple<Ts...>> : std::true_type { };
-
-      template<typename T>
-      constexpr decltype(auto) as_tuple(T t)
+      std::array<std::size_t, Buckets + 1> offsets{};
+      std::size_t count = 0;
+      for (const auto &element : input)
       {
-        return std::make_tuple(t);
+        ++offsets[key(element) + 1];
+        ++count;
       }
 
-      template<typename ...Ts>
-      constexpr decltype(auto) as_tuple(std::tuple<Ts...> t)
+      if (count > output.size())
+        return {};
+
+      for (std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+      auto next = offsets;
+      for (const auto &element : input)
+        output[next[key(element)]++] = element;
+
+      return offsets;
+    }
+
+    // splits output into buckets
+    template<std::size_t Groups, typename T, std::size_t N>
+    constexpr auto get_groups(std::span<T> output, const std::array<std::size_t, N> &offsets) noexcept
+    {
+      std::array<std::span<T>, Groups> groups{};
+      for (std::size_t i = 0; i < Groups; ++i)
+        groups[i] = output.subspan(offsets[i], offsets[i + 1] - offsets[i]);
+      return groups;
+    }
+
+    // FNV-1a, hash can be the result of a previous call to continue hashing from there
+    constexpr std::uint64_t hash_string(std::string_view string, std::uint64_t hash = 14695981039346656037ull) noexcept
+    {
+      for (char c : string)
       {
-        return t;
+        hash ^= (std::uint8_t)c;
+        hash *= 1099511628211ull;
       }
+      return hash;
+    }
 
-      constexpr decltype(auto) flatten(auto t)
+    constexpr std::uint64_t hash_integer(std::uint64_t value, std::uint64_t hash) noexcept
+    {
+      for (std::size_t i = 0; i < sizeof(value); ++i, value >>= 8)
       {
-        return t;
+        hash ^= value & 0xff;
+        hash *= 1099511628211ull;
       }
+      return hash;
+    }
+
+    // open addressing hash table over a fixed set of strings, mapping each string to its position in the set
+    // repeated strings occupy separate slots along the same probe sequence, so every match can be found
+    // probing only reads the hashes, the strings are kept apart and only compared when a hash matches
+    template<std::size_t N>
+    struct string_index
+    {
+      // always at least half empty so probes are short and guaranteed to terminate
+      static constexpr std::size_t capacity = std::bit_ceil(N * 2 + 1);
 
-      template<typename T>
-      constexpr decltype(auto) flatten(std::tuple<T> t)
+      // empty slots are all zeros, GCC 12 emits some of the untouched slots of constant initialised tables as zeros
+      // which would otherwise make them look full and turn every probe into a scan over the whole table
+      struct slot
       {
-        return flatten(std::get<0>(t));
-      }
+        std::uint64_t hash = 0;
+        // one past the position, 0 for empty slots
+        std::size_t next = 0;
+      };
 
-      template<typename ...Ts, std::enable_if_t<!(is_tuple<Ts>::value || ...), bool> = false>
-      constexpr decltype(auto) flatten(std::tuple<Ts...> t)
+      constexpr void insert(std::string_view string, std::size_t position) noexcept
       {
-        return t;
+        std::uint64_t hash = hash_string(string);
+        std::size_t i = (std::size_t)hash & (capacity - 1);
+        while (slots[i].next != 0)
+          i = (i + 1) & (capacity - 1);
+
+        slots[i] = { hash, position + 1 };
+        strings[i] = string;
       }
 
-      template<typename ...Ts, std::enable_if_t<(is_tuple<Ts>::value || ...), bool> = false>
-      constexpr decltype(auto) flatten(std::tuple<Ts...> t)
+      // calls function with the position of every occurrence of the string
+      constexpr void find(std::string_view string, auto &&function) const
       {
-        return std::apply([](auto...ts) { return flatten(std::tuple_cat(as_tuple(flatten(ts))...)); }, t);
+        std::uint64_t hash = hash_string(string);
+        for (std::size_t i = (std::size_t)hash & (capacity - 1); slots[i].next != 0; i = (i + 1) & (capacity - 1))
+          if (slots[i].hash == hash && strings[i] == string)
+            function(slots[i].next - 1);
       }
-    }
 
-    template<typename A>
-    inline constexpr auto is_std_array_v = requires
-    {
-      requires std::is_same_v<A, std::array<typename A::value_type, std::tuple_size_v<A>>>;
+      alignas(64) std::array<slot, capacity> slots{};
+      std::array<std::string_view, capacity> strings{};
     };
 
-    template<class TupleOrArray>
-    constexpr auto tuple_of_arrays_to_array(TupleOrArray &&tupleOrArray)
+    // decision tree over a fixed set of strings, mapping each string to its position in the set
+    // the root branches on the length, every inner node on the character at the position that splits
+    // its strings into the most groups, so a lookup reads a few characters and then compares a single string
+    // repeated strings map to their first position, empty slots in the set (no string) are skipped
+    template<std::size_t N>
+    struct string_matcher
     {
-      if constexpr (is_std_array_v<TupleOrArray>)
-        return tupleOrArray;
-      else
+      // leaves have no edges and hold the position of their string
+      struct node
+      {
+        std::uint32_t position = 0;
+        std::uint32_t firstEdge = 0;
+        std::uint32_t edgeCount = 0;
+      };
+      struct edge
+      {
+        char character = 0;
+        std::uint32_t node = 0;
+      };
+      struct length
+      {
+        std::size_t size = 0;
+        std::uint32_t node = 0;
+      };
+
+      template<typename Strings>
+      constexpr string_matcher(const Strings &set) noexcept
+      {
+        std::array<std::uint32_t, N> candidates{};
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < N; ++i)
+          if (get_string(set[i]).has_value())
+          {
+            strings[i] = *get_string(set[i]);
+            candidates[count++] = (std::uint32_t)i;
+          }
+
+        // sorting by length and then by position keeps every length together and the first of repeats in front
+        for (std::size_t i = 1; i < count; ++i)
+          for (std::size_t j = i; j > 0 && strings[candidates[j]].size() < strings[candidates[j - 1]].size(); --j)
+            std::swap(candidates[j], candidates[j - 1]);
+
+        for (std::size_t first = 0; first < count;)
+        {
+          std::size_t last = first + 1;
+          while (last < count && strings[candidates[last]].size() == strings[candidates[first]].size())
+            ++last;
+
+          lengths[lengthCount++] = { strings[candidates[first]].size(), build(candidates, first, last) };
+          first = last;
+        }
+      }
+
+      // returns the position of the string, or N if it isn't part of the set
+      constexpr std::size_t find(std::string_view string) const noexcept
       {
-        auto function = []<typename T, std::size_t M, typename ... Args>(std::array<T, M> first, Args ... args)
+        std::size_t first = 0, last = lengthCount;
+        while (first < last)
         {
-          if constexpr (sizeof...(Args) == 0)
-            return first;
+          std::size_t middle = first + (last - first) / 2;
+          if (lengths[middle].size < string.size())
+            first = middle + 1;
           else
-          {
-            constexpr std::size_t N = M + (args.size() + ...);
+            last = middle;
+        }
+        if (first == lengthCount || lengths[first].size != string.size())
+          return N;
 
-            std::array<T, N> newArray;
-            std::size_t index = 0;
+        const node *current = &nodes[lengths[first].node];
+        while (current->edgeCount != 0)
+        {
+          char character = string[current->position];
+          const edge *edgesEnd = edges.data() + current->firstEdge + current->edgeCount;
+          const edge *match = edges.data() + current->firstEdge;
+          while (match != edgesEnd && match->character != character)
+            ++match;
+          if (match == edgesEnd)
+            return N;
+
+          current = &nodes[match->node];
+        }
 
-            auto iterate = [&index, &newArray](auto current)
-            {
-              for (std::size_t i = 0; i < current.size(); i++)
-                newArray[index + i] = current[i];
+        return (strings[current->position] == string) ? current->position : N;
+      }
 
-              index += current.size();
-            };
+    private:
+      static constexpr std::optional<std::string_view> get_string(std::string_view string) noexcept { return string; }
+      static constexpr std::optional<std::string_view> get_string(const std::optional<std::string_view> &string) noexcept { return string; }
 
-            iterate(first);
-            (iterate(args), ...);
+      // builds the subtree of candidates [first, last), which all have the same length, and returns its node
+      constexpr std::uint32_t build(std::array<std::uint32_t, N> &candidates, std::size_t first, std::size_t last) noexcept
+      {
+        std::uint32_t index = (std::uint32_t)nodeCount++;
+        std::size_t size = strings[candidates[first]].size();
 
-            return newArray;
+        // the position with the most distinct characters, none if all the strings are the same
+        std::size_t bestPosition = size, bestCount = 1;
+        for (std::size_t position = 0; position < size; ++position)
+        {
+          std::array<bool, 256> seen{};
+          std::size_t distinct = 0;
+          for (std::size_t i = first; i < last; ++i)
+          {
+            auto character = (unsigned char)strings[candidates[i]][position];
+            distinct += !seen[character];
+            seen[character] = true;
           }
-        };
+          if (distinct > bestCount)
+          {
+            bestPosition = position;
+            bestCount = distinct;
+          }
+        }
+
+        if (bestPosition == size)
+        {
+          nodes[index] = { candidates[first], 0, 0 };
+          return index;
+        }
+
+        // stable sort by the character so that every group is contiguous and keeps the order of positions
+        for (std::size_t i = first + 1; i < last; ++i)
+          for (std::size_t j = i; j > first && strings[candidates[j]][bestPosition] < strings[candidates[j - 1]][bestPosition]; --j)
+            std::swap(candidates[j], candidates[j - 1]);
+
+        std::uint32_t firstEdge = (std::uint32_t)edgeCount;
+        edgeCount += bestCount;
+        nodes[index] = { (std::uint32_t)bestPosition, firstEdge, (std::uint32_t)bestCount };
+
+        for (std::size_t group = first, edgeIndex = firstEdge; group < last; ++edgeIndex)
+        {
+          std::size_t groupEnd = group + 1;
+          while (groupEnd < last && strings[candidates[groupEnd]][bestPosition] == strings[candidates[group]][bestPosition])
+            ++groupEnd;
+
+          char character = strings[candidates[group]][bestPosition];
+          std::uint32_t child = build(candidates, group, groupEnd);
+          edges[edgeIndex] = { character, child };
+          group = groupEnd;
+        }
+
+        return index;
+      }
 
-        return [&]<std::size_t ... Indices>(std::index_sequence<Indices...>)
+      // every split adds at least one node, so there are less than 2 * N nodes and edges
+      std::array<std::string_view, N> strings{};
+      std::array<length, N> lengths{};
+      std::array<node, 2 * N + 1> nodes{};
+      std::array<edge, 2 * N + 1> edges{};
+      std::size_t lengthCount = 0;
+      std::size_t nodeCount = 0;
+      std::size_t edgeCount = 0;
+    };
+
+    // unsigned LEB128, returns the number of bytes written or 0 if the buffer is too small
+    constexpr std::size_t write_varint(std::uint64_t value, std::span<std::uint8_t> buffer) noexcept
+    {
+      std::size_t size = 0;
+      do
+      {
+        if (size == buffer.size())
+          return 0;
+
+        auto byte = (std::uint8_t)(value & 0x7f);
+        value >>= 7;
+        buffer[size++] = byte | (value != 0 ? 0x80 : 0);
+      } while (value != 0);
+
+      return size;
+    }
+
+    // returns the value and the number of bytes read, or 0 bytes if the varint doesn't end inside the buffer
+    // only the shortest encoding of a value is accepted (as written by write_varint), so every value has exactly one,
+    // a last byte of 0 after the first one or bits past 64 make it invalid
+    constexpr auto read_varint(std::span<const std::uint8_t> buffer) noexcept -> std::pair<std::uint64_t, std::size_t>
+    {
+      std::uint64_t value = 0;
+      for (std::size_t i = 0; i < buffer.size() && i < 10; ++i)
+      {
+        if (i == 9 && buffer[i] > 1)
+          break;
+
+        value |= (std::uint64_t)(buffer[i] & 0x7f) << (7 * i);
+        if ((buffer[i] & 0x80) == 0)
         {
-          return function(std::get<Indices>(tupleOrArray)...);
-        }(std::make_index_sequence<std::tuple_size_v<TupleOrArray>>{});
+          if (i != 0 && buffer[i] == 0)
+            break;
+          return { value, i + 1 };
+        }
       }
+
+      return { 0, 0 };
     }
 
-    constexpr std::string_view get_substring(std::string_view allStrings, std::size_t index, bool clean) noexcept
+    constexpr void write_little_endian(std::uint64_t value, std::size_t bytes, std::uint8_t *destination) noexcept
     {
-      std::size_t end = 0;
-      std::size_t count = 0;
-      while (count < index)
-        if (allStrings[end++] == '\0')
-          ++count;
+      for (std::size_t i = 0; i < bytes; ++i, value >>= 8)
+        destination[i] = (std::uint8_t)(value & 0xff);
+    }
+
+    constexpr std::uint64_t read_little_endian(const std::uint8_t *source, std::size_t bytes) noexcept
+    {
+      std::uint64_t value = 0;
+      for (std::size_t i = 0; i < bytes; ++i)
+        value |= (std::uint64_t)source[i] << (8 * i);
+      return value;
+    }
+
+    // where every value of a subtree ends up when the values of all its nodes are laid out in preorder
+    template<std::size_t Nodes, std::size_t N>
+    struct recursive_layout
+    {
+      // node and position inside the node of every value
+      std::array<std::size_t, N> nodes{};
+      std::array<std::size_t, N> entries{};
+      // position of the first value of every node
+      std::array<std::size_t, Nodes> offsets{};
+      // one past the last node in the subtree of every node
+      std::array<std::size_t, Nodes> subtreeEnds{};
+    };
+
+    // index over the strings of all values in a subtree, Strings is at least N as aliases map to the values they belong to
+    template<std::size_t Nodes, std::size_t N, std::size_t Strings = N>
+    struct recursive_index
+    {
+      struct result
+      {
+        bool isFound = false;
+        bool isAmbiguous = false;
+        std::size_t node = 0;
+        std::size_t entry = 0;
+      };
+
+      // returns the first match in preorder, which is ambiguous
+      // if any other match doesn't lie inside the subtree of its node
+      constexpr result find(std::string_view string) const
+      {
+        std::size_t first = N;
+        strings.find(string, [&](std::size_t position) { first = (position < first) ? position : first; });
+        if (first == N)
+          return {};
+
+        result match{ true, false, layout.nodes[first], layout.entries[first] };
+        strings.find(string, [&](std::size_t position)
+          {
+            if (layout.nodes[position] < match.node || layout.nodes[position] >= layout.subtreeEnds[match.node])
+              match.isAmbiguous = true;
+          });
+        return match;
+      }
+
+      recursive_layout<Nodes, N> layout{};
+      string_index<Strings> strings{};
+    };
+
+    struct no_id { };
+
+    // instantiated by the NESTED_ENUM macro only when an enum has more entries than it can walk
+    template<bool isWithinLimit>
+    struct entry_limit
+    {
+      static_assert(isWithinLimit, "NESTED_ENUM supports at most 2048 entries per enum");
+      static constexpr int value = 0;
+    };
+
+    // instantiated by the NESTED_ENUM macro only when a tree is nested deeper than it can expand
+    template<bool isWithinLimit>
+    struct depth_limit
+    {
+      static_assert(isWithinLimit, "NESTED_ENUM supports at most 20 levels of nested enums below the root of a tree");
+      static constexpr bool value = true;
+    };
+
+    // compile-time description of a single enum entry, generated by the NESTED_ENUM macro
+    template<typename T, auto value, fixed_string name, auto id = no_id{}>
+    struct entry { };
+
+    // all entries of an enum in declaration order
+    template<typename E, typename ... Entries>
+    struct entries { };
+
+    template<typename E, typename ... Ts, auto ... values, fixed_string ... names, auto ... ids>
+    consteval auto get_array_of_values(entries<E, entry<Ts, values, names, ids>...>)
+    {
+      return std::array<E, sizeof...(values)>{ values... };
+    }
+
+    template<fixed_string type, typename E, typename ... Ts, auto ... values, fixed_string ... names, auto ... ids>
+    consteval auto get_string_values(entries<E, entry<Ts, values, names, ids>...>)
+    {
+      static_assert(type.size() > 0);
+
+      // every name is "type::value" followed by a null terminator
+      constexpr std::size_t size = ((type.size() + scopeResolution.size() + names.size() + 1) + ... + 0);
+      fixed_string<size> result{};
+      std::size_t index = 0;
+
+      auto append = [&](std::string_view string)
+      {
+        for (std::size_t i = 0; i < string.size(); ++i)
+          result.data[index++] = string[i];
+      };
+
+      ((append(type), append(scopeResolution), append(names), result.data[index++] = '\0'), ...);
+      result.data[size] = '\0';
+
+      return result;
+    }
+
+    template<typename E, typename ... Ts, auto ... values, fixed_string ... names, auto ... ids>
+    consteval auto get_array_of_ids(entries<E, entry<Ts, values, names, ids>...>)
+    {
+      auto getId = []<auto id>() -> std::optional<std::string_view>
+      {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(id)>, no_id>)
+          return {};
+        else
+          return std::string_view{ id };
+      };
+
+      return std::array<std::optional<std::string_view>, sizeof...(ids)>{ getId.template operator()<ids>()... };
+    }
 
-      std::string_view view = std::string_view(&allStrings[end]);
+    template<typename E, typename ... Ts, auto ... values, fixed_string ... names, auto ... ids>
+    consteval auto get_subtypes(entries<E, entry<Ts, values, names, ids>...>)
+    {
+      return type_list<Ts...>{};
+    }
+
+    // other names a single entry is also found by, generated by the NESTED_ENUM macro from the ALIAS specifiers
+    template<fixed_string ... names>
+    struct aliases
+    {
+      static constexpr std::size_t count = sizeof...(names);
+      static constexpr std::size_t length = (names.size() + ... + 0);
+      static constexpr std::array<std::string_view, count> strings{ std::string_view{ names }... };
+    };
+
+    // the aliases of all entries of an enum in declaration order
+    template<typename E, typename ... Aliases>
+    struct entry_aliases { };
+
+    // every alias is "type::alias" followed by a null terminator, positions are those of the entries they belong to
+    template<std::size_t Size, std::size_t Count>
+    struct alias_names
+    {
+      fixed_string<Size> names{};
+      std::array<std::size_t, Count> positions{};
+    };
+
+    template<fixed_string type, typename E, typename ... Aliases>
+    consteval auto get_alias_names(entry_aliases<E, Aliases...>)
+    {
+      constexpr std::size_t count = (Aliases::count + ... + 0);
+      constexpr std::size_t size = (Aliases::length + ... + 0) + count * (type.size() + scopeResolution.size() + 1);
+      alias_names<size, count> result{};
+      std::size_t index = 0, alias = 0, position = 0;
+
+      auto append = [&](std::string_view string)
+      {
+        for (std::size_t i = 0; i < string.size(); ++i)
+          result.names.data[index++] = string[i];
+      };
+
+      auto addEntry = [&]<typename T>()
+      {
+        for (std::string_view string : T::strings)
+        {
+          append(type), append(scopeResolution), append(string), result.names.data[index++] = '\0';
+          result.positions[alias++] = position;
+        }
+        ++position;
+      };
+
+      (addEntry.template operator()<Aliases>(), ...);
+      result.names.data[size] = '\0';
+
+      return result;
+    }
+
+    // returns the string starting at offset and moves offset past its null terminator
+    constexpr std::string_view get_next_substring(std::string_view allStrings, std::size_t &offset, bool clean) noexcept
+    {
+      std::string_view view = std::string_view(&allStrings[offset]);
+      offset += view.size() + 1;
 
       if (clean)
       {
@@ -288,84 +781,413 @@ namespace nested_enum
   // All   - both inner and outer enum values 
   enum InnerOuterAll { Inner, Outer, All };
 
-  template<class E, class P = E>
-  struct nested_enum
+  namespace detail
   {
-    using type = E;
-    using parent = P;
-
-    template<class, class>
-    friend struct nested_enum;
-    using nested_enum_tag = void;
-
-    // returns the reflected type name of the enum 
-    static constexpr auto name(bool clean = false) noexcept -> std::string_view
+    // true if no alias of E is repeated or is also the name of a value, otherwise lookups couldn't tell them apart
+    template<typename E, std::size_t Size, std::size_t Count>
+    consteval bool are_aliases_unique(const alias_names<Size, Count> &aliases)
     {
-      std::string_view name = E::internalName;
-      if (clean)
+      constexpr auto enumNames = E::template enum_names<All>(false);
+      std::size_t offset = 0;
+      for (std::size_t i = 0; i < Count; ++i)
       {
-        std::string_view scope = "::";
-        name.remove_prefix(name.rfind(scope) + scope.length());
+        std::string_view alias = get_next_substring(std::string_view(aliases.names), offset, false);
+        if (find_index(enumNames, alias).has_value())
+          return false;
+
+        for (std::size_t j = i + 1, otherOffset = offset; j < Count; ++j)
+          if (get_next_substring(std::string_view(aliases.names), otherOffset, false) == alias)
+            return false;
       }
-      return name;
-    }
-    // returns the id of the type name (if it has one)
-    static constexpr auto id() noexcept -> std::optional<std::string_view>
-    {
-      if constexpr (std::is_same_v<E, P>)
-        return {};
-      else
-        return P::enum_id(E::value());
-    }
-    // returns the integer of the type name (if it has one)
-    static constexpr auto integer() noexcept
-    {
-      return static_cast<typename E::underlying_type>(E::value());
+      return true;
     }
-    // returns the global id of the topmost parent
-    static constexpr auto global_prefix() -> std::string_view
+
+    // the aliases of E, there are none if E has no entries or names were left out
+    template<typename E>
+    inline constexpr auto aliasNames = []()
     {
-      if constexpr (std::is_same_v<E, P>)
-        return std::string_view{ E::internalGlobalPrefix };
+      if constexpr (requires { E::internalAliases; })
+      {
+        constexpr auto aliases = get_alias_names<E::internalName>(E::internalAliases);
+        static_assert(are_aliases_unique<E>(aliases), "An alias of an enum value is repeated or is the name of another value");
+        return aliases;
+      }
       else
-        return parent::global_prefix();
-    }
-    // returns an instance of this type with the given value if it exist
-    template<typename T> requires std::is_integral_v<T> || std::is_floating_point_v<T>
-    static constexpr auto make_enum(T t) -> std::optional<E>
-    {
-      return enum_value(static_cast<typename E::underlying_type>(t));
-    }
+        return alias_names<0, 0>{};
+    }();
 
+    template<typename E>
+    inline constexpr std::size_t aliasCount = aliasNames<E>.positions.size();
 
-    // returns the string of the currently held value
-    constexpr auto enum_name(bool clean = false) const noexcept -> std::string_view
+    // full or clean names of the aliases of E
+    template<typename E, bool clean>
+    inline constexpr auto aliasStrings = []()
     {
-      return enum_name(static_cast<const E &>(*this), clean).value();
-    }
-    // returns the id of the currently held value
-    constexpr auto enum_id() const noexcept -> std::optional<std::string_view>
+      std::array<std::string_view, aliasCount<E>> strings{};
+      for (std::size_t i = 0, offset = 0; i < strings.size(); ++i)
+        strings[i] = get_next_substring(std::string_view(aliasNames<E>.names), offset, clean);
+      return strings;
+    }();
+
+    // hashed index over the full or clean names of the values of E, aliases map to the values they belong to
+    template<typename E, bool clean>
+    inline constexpr auto nameIndex = []()
     {
-      return enum_id(static_cast<const E &>(*this));
-    }
-    // returns the string and id of the currently held value
-    constexpr auto enum_name_and_id(bool clean = false) const noexcept -> std::pair<std::string_view, std::optional<std::string_view>>
+      string_index<E::enumValues.size() + aliasCount<E>> index{};
+      constexpr auto enumNames = E::template enum_names<All>(clean);
+      for (std::size_t i = 0; i < enumNames.size(); ++i)
+        index.insert(enumNames[i], i);
+      for (std::size_t i = 0; i < aliasCount<E>; ++i)
+        index.insert(aliasStrings<E, clean>[i], aliasNames<E>.positions[i]);
+      return index;
+    }();
+
+    // hashed index over the ids of the values of E that have one
+    template<typename E>
+    inline constexpr auto idIndex = []()
     {
-      return enum_name_and_id(static_cast<const E &>(*this), clean).value();
-    }
-    // returns the integer representation of the currently held value
-    constexpr auto enum_integer() const noexcept
+      string_index<E::enumValues.size()> index{};
+      for (std::size_t i = 0; i < E::enumIds.size(); ++i)
+        if (E::enumIds[i].has_value())
+          index.insert(E::enumIds[i].value(), i);
+      return index;
+    }();
+
+    // decision trees over the full names or the ids of the values of E
+    // the aliases follow the names, see aliasPositions
+    template<typename E, bool byId>
+    inline constexpr auto stringMatcher = []()
     {
-      return (typename E::underlying_type)static_cast<const E &>(*this).internalValue;
-    }
+      constexpr std::size_t size = E::enumValues.size();
+      if constexpr (byId)
+        return string_matcher<size>{ E::enumIds };
+      else if constexpr (aliasCount<E> == 0)
+        return string_matcher<size>{ E::template enum_names<All>(false) };
+      else
+      {
+        constexpr auto enumNames = E::template enum_names<All>(false);
+        std::array<std::string_view, size + aliasCount<E>> strings{};
+        for (std::size_t i = 0; i < size; ++i)
+          strings[i] = enumNames[i];
+        for (std::size_t i = 0; i < aliasCount<E>; ++i)
+          strings[size + i] = aliasStrings<E, false>[i];
+        return string_matcher<size + aliasCount<E>>{ strings };
+      }
+    }();
 
-  protected:
-    template<std::size_t N>
-    static constexpr auto create_name(fixed_string<N> name)
+    // position of the value every alias in the name decision tree belongs to, followed by the number of values for no match
+    template<typename E>
+    inline constexpr auto aliasPositions = []()
     {
-      if constexpr (std::is_same_v<E, P>)
+      std::array<std::size_t, aliasCount<E> + 1> positions{};
+      for (std::size_t i = 0; i < aliasCount<E>; ++i)
+        positions[i] = aliasNames<E>.positions[i];
+      positions[aliasCount<E>] = E::enumValues.size();
+      return positions;
+    }();
+  }
+
+  // how the functions of a single enum that take a full name or an id find it
+  //   linear        - compares it with every name or id in declaration order
+  //   hash          - looks it up in a hash table
+  //   decision_tree - branches on its length and then on the characters that tell the names or ids apart,
+  //                   and compares it with a single one of them
+  enum class lookup_strategy { linear, hash, decision_tree };
+
+  // the lookup strategy of E, specialise it to pick one for a specific enum
+  // by default enums of up to 16 values compare linearly (optimisers unroll it, which beats the other two), up to 64
+  // values they use decision trees and larger ones hash tables
+  template<typename E>
+  inline constexpr lookup_strategy enum_lookup_strategy = (E::enumValues.size() <= 16) ? lookup_strategy::linear
+    : (E::enumValues.size() <= 64) ? lookup_strategy::decision_tree : lookup_strategy::hash;
+
+  namespace detail
+  {
+    // position of the value with the given full name, alias (or id), or the number of values if there is none
+    // repeated ids resolve to the first one in every strategy
+    template<typename E, bool byId, lookup_strategy Strategy = enum_lookup_strategy<E>>
+    constexpr std::size_t find_string(std::string_view string) noexcept
+    {
+      constexpr std::size_t size = E::enumValues.size();
+      if constexpr (Strategy == lookup_strategy::decision_tree)
       {
-        if constexpr (E::internalGlobalPrefix.size() == 0)
+        if constexpr (byId || aliasCount<E> == 0)
+          return stringMatcher<E, byId>.find(string);
+        else
+        {
+          std::size_t match = stringMatcher<E, false>.find(string);
+          return (match < size) ? match : aliasPositions<E>[match - size];
+        }
+      }
+      else if constexpr (Strategy == lookup_strategy::hash)
+      {
+        std::size_t position = size;
+        auto keepFirst = [&](std::size_t match) { position = (match < position) ? match : position; };
+        if constexpr (byId)
+          idIndex<E>.find(string, keepFirst);
+        else
+          nameIndex<E, false>.find(string, keepFirst);
+        return position;
+      }
+      else
+      {
+        std::optional<std::size_t> index;
+        if constexpr (byId)
+          index = find_index(E::enumIds, string);
+        else
+          index = find_index(E::template enum_names_view<All>(), string);
+
+        if constexpr (!byId && aliasCount<E> != 0)
+          if (!index.has_value())
+            if (auto alias = find_index(aliasStrings<E, false>, string); alias.has_value())
+              index = aliasNames<E>.positions[alias.value()];
+        return index.value_or(size);
+      }
+    }
+  }
+
+#ifdef NESTED_ENUM_INSTRUMENTATION
+  // runtime lookups that are counted, named after the function and what it takes
+  enum class lookup_api : std::uint8_t
+  {
+    enum_name, enum_name_by_id, enum_id, enum_id_by_name, enum_name_and_id, enum_integer_by_name, enum_integer_by_id,
+    enum_value_by_integer, enum_value_by_name, enum_value_by_id, enum_name_by_id_recursive, enum_id_by_name_recursive
+  };
+  inline constexpr std::size_t lookupApiCount = 12;
+
+  constexpr auto lookup_api_name(lookup_api api) noexcept -> std::string_view
+  {
+    constexpr std::array<std::string_view, lookupApiCount> names{ "enum_name", "enum_name_by_id", "enum_id", "enum_id_by_name",
+      "enum_name_and_id", "enum_integer_by_name", "enum_integer_by_id", "enum_value_by_integer", "enum_value_by_name",
+      "enum_value_by_id", "enum_name_by_id_recursive", "enum_id_by_name_recursive" };
+    return names[(std::size_t)api];
+  }
+
+  // scanned are the entries compared one by one, by linear lookups and by the recursive ones that go through enums
+  // one after another, indexed lookups don't add to it
+  struct lookup_counters
+  {
+    std::uint64_t calls = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t scanned = 0;
+  };
+
+  namespace detail
+  {
+    // counters of one enum that belong to a single thread at a time and are handed over to the next thread once it exits
+    // only the owner writes them, relaxed loads and stores are enough for other threads to read them
+    struct lookup_block
+    {
+      const void *key = nullptr;
+      std::string_view name{};
+      std::array<std::array<std::atomic<std::uint64_t>, 4>, lookupApiCount> counters{};
+      std::atomic<bool> owned{ true };
+      lookup_block *next = nullptr;
+    };
+
+    // every block that was ever made, they are never freed so that counts outlive the threads that made them
+    inline std::atomic<lookup_block *> lookupBlocks{ nullptr };
+
+    inline lookup_block *acquire_lookup_block(const void *key, std::string_view name)
+    {
+      for (auto *block = lookupBlocks.load(std::memory_order_acquire); block != nullptr; block = block->next)
+      {
+        bool owned = false;
+        if (block->key == key && block->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+          return block;
+      }
+
+      auto *block = new lookup_block{ key, name };
+      block->next = lookupBlocks.load(std::memory_order_relaxed);
+      while (!lookupBlocks.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed));
+      return block;
+    }
+
+    struct lookup_block_owner
+    {
+      lookup_block *block;
+      ~lookup_block_owner() { block->owned.store(false, std::memory_order_release); }
+    };
+
+    // only its address is used, to tell enums apart
+    template<typename E>
+    inline constexpr char lookupKey = 0;
+
+    // block of E that the calling thread owns, a function local thread_local is initialised on first use on every thread
+    template<typename E>
+    lookup_block &thread_lookup_block()
+    {
+      thread_local lookup_block_owner owner{ acquire_lookup_block(&lookupKey<E>, []()
+        {
+          if constexpr (hasNames<E>)
+            return E::name();
+          else
+            return std::string_view{};
+        }()) };
+      return *owner.block;
+    }
+
+    template<typename E>
+    constexpr void count_lookup(lookup_api api, bool found, std::size_t scanned)
+    {
+      if (std::is_constant_evaluated())
+        return;
+
+      auto &counters = thread_lookup_block<E>().counters[(std::size_t)api];
+      auto add = [](std::atomic<std::uint64_t> &counter, std::uint64_t amount)
+      {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+      };
+      add(counters[0], 1);
+      add(counters[found ? 1 : 2], 1);
+      add(counters[3], scanned);
+    }
+
+    // entries a lookup compared one by one to find position, which is all of them if it wasn't found
+    template<typename E, lookup_strategy Strategy = enum_lookup_strategy<E>>
+    constexpr std::size_t scanned_entries(std::size_t position) noexcept
+    {
+      if constexpr (Strategy == lookup_strategy::linear)
+        return (position < E::enumValues.size()) ? position + 1 : E::enumValues.size();
+      else
+        return 0;
+    }
+  }
+
+  // calls function(name, api, counters) for every enum and lookup that was called at least once, summed over all threads
+  // including the ones that have exited, name is the name() of the enum or empty if names were left out
+  template<typename Function>
+  void for_each_lookup_counter(Function &&function)
+  {
+    auto *first = detail::lookupBlocks.load(std::memory_order_acquire);
+    for (auto *block = first; block != nullptr; block = block->next)
+    {
+      // the first block of every enum reports the sum of all of its blocks
+      bool isFirst = true;
+      for (auto *other = first; other != block && isFirst; other = other->next)
+        isFirst = other->key != block->key;
+      if (!isFirst)
+        continue;
+
+      for (std::size_t api = 0; api < lookupApiCount; ++api)
+      {
+        std::array<std::uint64_t, 4> sums{};
+        for (auto *other = block; other != nullptr; other = other->next)
+          if (other->key == block->key)
+            for (std::size_t i = 0; i < sums.size(); ++i)
+              sums[i] += other->counters[api][i].load(std::memory_order_relaxed);
+
+        if (sums[0] > 0)
+          std::invoke(function, block->name, (lookup_api)api, lookup_counters{ sums[0], sums[1], sums[2], sums[3] });
+      }
+    }
+  }
+
+  // sets every counter to 0, lookups that run at the same time on other threads may keep part of their counts
+  inline void reset_lookup_counters() noexcept
+  {
+    for (auto *block = detail::lookupBlocks.load(std::memory_order_acquire); block != nullptr; block = block->next)
+      for (auto &counters : block->counters)
+        for (auto &counter : counters)
+          counter.store(0, std::memory_order_relaxed);
+  }
+
+  // writes a line for every enum and lookup that was called at least once
+  template<typename Traits>
+  void dump_lookup_counters(std::basic_ostream<char, Traits> &stream)
+  {
+    for_each_lookup_counter([&](std::string_view name, lookup_api api, const lookup_counters &counters)
+      {
+        stream << name << ' ' << lookup_api_name(api) << ": " << counters.calls << " calls, " << counters.hits << " hits, "
+          << counters.misses << " misses, " << counters.scanned << " scanned\n";
+      });
+  }
+#endif
+
+  template<typename E>
+  struct tree_codec;
+
+  template<class E, class P = E>
+  struct nested_enum
+  {
+    using type = E;
+    using parent = P;
+
+    template<class, class>
+    friend struct nested_enum;
+    template<typename>
+    friend struct tree_codec;
+    using nested_enum_tag = void;
+
+    // returns the reflected type name of the enum 
+    static constexpr auto name(bool clean = false) noexcept -> std::string_view requires detail::hasNames<E>
+    {
+      std::string_view name = E::internalName;
+      if (clean)
+      {
+        std::string_view scope = "::";
+        name.remove_prefix(name.rfind(scope) + scope.length());
+      }
+      return name;
+    }
+    // returns the id of the type name (if it has one)
+    static constexpr auto id() noexcept -> std::optional<std::string_view> requires detail::hasIds<E>
+    {
+      if constexpr (std::is_same_v<E, P>)
+        return {};
+      else
+        return P::enum_id(E::value());
+    }
+    // returns the integer of the type name (if it has one)
+    static constexpr auto integer() noexcept
+    {
+      return static_cast<typename E::underlying_type>(E::value());
+    }
+    // returns the global id of the topmost parent
+    static constexpr auto global_prefix() -> std::string_view requires detail::hasNames<E>
+    {
+      if constexpr (std::is_same_v<E, P>)
+        return std::string_view{ E::internalGlobalPrefix };
+      else
+        return parent::global_prefix();
+    }
+    // returns an instance of this type with the given value if it exist
+    template<typename T> requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    static constexpr auto make_enum(T t) -> std::optional<E>
+    {
+      return enum_value(static_cast<typename E::underlying_type>(t));
+    }
+
+
+    // returns the string of the currently held value
+    constexpr auto enum_name(bool clean = false) const noexcept -> std::string_view requires detail::hasNames<E>
+    {
+      return enum_name(static_cast<const E &>(*this), clean).value();
+    }
+    // returns the id of the currently held value
+    constexpr auto enum_id() const noexcept -> std::optional<std::string_view> requires detail::hasIds<E>
+    {
+      return enum_id(static_cast<const E &>(*this));
+    }
+    // returns the string and id of the currently held value
+    constexpr auto enum_name_and_id(bool clean = false) const noexcept -> std::pair<std::string_view, std::optional<std::string_view>> requires detail::hasNames<E> && detail::hasIds<E>
+    {
+      return enum_name_and_id(static_cast<const E &>(*this), clean).value();
+    }
+    // returns the integer representation of the currently held value
+    constexpr auto enum_integer() const noexcept
+    {
+      return (typename E::underlying_type)static_cast<const E &>(*this).internalValue;
+    }
+
+  protected:
+    template<std::size_t N>
+    static constexpr auto create_name(fixed_string<N> name)
+    {
+      if constexpr (std::is_same_v<E, P>)
+      {
+        if constexpr (E::internalGlobalPrefix.size() == 0)
           return name;
         else
         {
@@ -475,7 +1297,7 @@ namespace nested_enum
       return integerArray;
     }
     // returns the ids of enum values that satisfy the selection
-    template<InnerOuterAll Selection = All>
+    template<InnerOuterAll Selection = All> requires detail::hasIds<E>
     static constexpr auto enum_ids() noexcept
     {
       if constexpr (E::enumIds.size() == 0 || Selection == All)
@@ -499,7 +1321,7 @@ namespace nested_enum
     }
     // returns the reflected strings of enum values that satisfy the selection
     // "clean" refers to whether only the enum value name or its entire path is returned
-    template<InnerOuterAll Selection = All>
+    template<InnerOuterAll Selection = All> requires detail::hasNames<E>
     static constexpr auto enum_names(bool clean = false) noexcept
     {
       if constexpr (enum_count(Selection) == 0)
@@ -515,9 +1337,12 @@ namespace nested_enum
           constexpr auto valuesNeeded = get_needed_values<Selection>(E::subtypes);
 
           std::array<std::string_view, valuesNeeded.second> values;
-          for (std::size_t i = 0, j = 0; i < valuesNeeded.first.size(); i++)
+          for (std::size_t i = 0, j = 0, offset = 0; i < valuesNeeded.first.size(); i++)
+          {
+            auto string = detail::get_next_substring(std::string_view(E::enumNames), offset, cleanString);
             if (valuesNeeded.first[i])
-              values[j++] = detail::get_substring(std::string_view(E::enumNames), i, cleanString);
+              values[j++] = string;
+          }
           
           return values;
         };
@@ -532,7 +1357,7 @@ namespace nested_enum
     }
     // returns the reflected strings and ids of enum values that satisfy the selection
     // "clean" refers to whether only the enum value name or its entire path is returned
-    template<InnerOuterAll Selection = All>
+    template<InnerOuterAll Selection = All> requires detail::hasNames<E> && detail::hasIds<E>
     static constexpr auto enum_names_and_ids(bool clean = false) noexcept
     {
       if constexpr (enum_count(Selection) == 0)
@@ -544,9 +1369,12 @@ namespace nested_enum
           constexpr auto valuesNeeded = get_needed_values<Selection>(E::subtypes);
 
           std::array<std::pair<std::string_view, std::optional<std::string_view>>, valuesNeeded.second> values{};
-          for (std::size_t i = 0, j = 0; i < valuesNeeded.first.size(); i++)
+          for (std::size_t i = 0, j = 0, offset = 0; i < valuesNeeded.first.size(); i++)
+          {
+            auto string = detail::get_next_substring(std::string_view(E::enumNames), offset, false);
             if (valuesNeeded.first[i])
-              values[j++] = { detail::get_substring(E::enumNames, i, false), E::enumIds[i] };
+              values[j++] = { string, E::enumIds[i] };
+          }
 
           return values;
         }();
@@ -631,19 +1459,18 @@ namespace nested_enum
       return count;
     }
   private:
-    template<auto Predicate, InnerOuterAll Selection>
-    static constexpr auto return_recursive_internal() noexcept
+    // returns a type_list of all enums in the subtree (in preorder) whose values are needed for a recursive query
+    template<InnerOuterAll Selection>
+    static constexpr auto get_nodes_recursive_internal() noexcept
     {
       if constexpr (E::enumValues.size() == 0)
-        return std::tuple<>{};
+        return detail::type_list<>{};
       else
       {
-        constexpr auto values = Predicate.template operator()<E>();
-
-        // getting an array of values we need
-        constexpr auto subtypesToQuery = [&]<typename ... Ts>(detail::type_list<Ts...>)
+        // getting the subtypes we need to query
+        constexpr auto subtypesToQuery = []<typename ... Ts>(detail::type_list<Ts...>)
         {
-          // new tuple of only the inner enum nodes
+          // new list of only the inner enum nodes
           auto checkQueries = []<typename T>()
           {
             // does the enum exist
@@ -682,24 +1509,53 @@ namespace nested_enum
           return (checkQueries.template operator()<Ts>() + ...);
         }(E::subtypes);
 
-        // returning only the values if we don't have any subtypes to query
-        if constexpr (subtypesToQuery.size == 0)
-          return std::make_tuple(values);
-        else
+        constexpr auto subtypesNodes = []<typename ... Ts>(detail::type_list<Ts...>)
         {
-          constexpr auto subtypesTuples = []<typename ... Ts>(detail::type_list<Ts...>)
-          {
-            auto expand = []<typename T>() { return T::template return_recursive_internal<Predicate, Selection>(); };
-            return std::make_tuple(expand.template operator()<Ts>()...);
-          }(subtypesToQuery);
+          return (detail::type_list<>{} + ... + Ts::template get_nodes_recursive_internal<Selection>());
+        }(subtypesToQuery);
 
-          if constexpr (values.size() == 0)
-            return subtypesTuples;
-          else
-            return std::tuple_cat(std::make_tuple(values), subtypesTuples);
-        }
+        // skipping this enum only if it has nothing to contribute
+        if constexpr (enum_count(Selection) == 0 && subtypesToQuery.size > 0)
+          return subtypesNodes;
+        else
+          return detail::type_list<E>{} + subtypesNodes;
       }
     }
+    // returns the arrays of all nodes in the subtree as a tuple, or just the array if there's only a single node
+    template<auto Predicate, InnerOuterAll Selection>
+    static constexpr auto return_recursive_internal() noexcept
+    {
+      return []<typename ... Ts>(detail::type_list<Ts...>)
+      {
+        if constexpr (sizeof...(Ts) == 1)
+          return Predicate.template operator()<Ts...>();
+        else
+          return std::tuple{ Predicate.template operator()<Ts>()... };
+      }(get_nodes_recursive_internal<Selection>());
+    }
+    // returns the arrays of all nodes in the subtree concatenated into a single array
+    // the size is known upfront so the whole array is filled in a single pass
+    template<auto Predicate, InnerOuterAll Selection>
+    static constexpr auto flatten_recursive_internal() noexcept
+    {
+      return []<typename ... Ts>(detail::type_list<Ts...>)
+      {
+        using value_type = typename decltype(Predicate.template operator()<E>())::value_type;
+        constexpr std::size_t size = (Predicate.template operator()<Ts>().size() + ... + 0);
+
+        std::array<value_type, size> result{};
+        std::size_t index = 0;
+
+        auto append = [&](const auto &array)
+        {
+          for (std::size_t i = 0; i < array.size(); ++i)
+            result[index++] = array[i];
+        };
+
+        (append(Predicate.template operator()<Ts>()), ...);
+        return result;
+      }(get_nodes_recursive_internal<Selection>());
+    }
   public:
     // returns std::tuple<std::array<Enum, ?>...> 
     // of all enum values in the subtree that satisfy the selection
@@ -711,13 +1567,13 @@ namespace nested_enum
         return T::template enum_values<Selection>();
       };
 
-      constexpr auto tuple = detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>());
+      constexpr auto tuple = return_recursive_internal<predicate, Selection>();
       return tuple;
     }
     // returns std::tuple<std::array<std::string_view, ?>...> 
     // of the reflected names of all enum values in the subtree that satisfy the selection
     // if flattenTuple == true, the tuple of arrays will be flattened to a single array with all strings inside
-    template<InnerOuterAll Selection = All, bool flattenTuple = true, bool clean = false>
+    template<InnerOuterAll Selection = All, bool flattenTuple = true, bool clean = false> requires detail::hasNames<E>
     static constexpr auto enum_names_recursive() noexcept
     {
       constexpr auto predicate = []<typename T>()
@@ -727,19 +1583,19 @@ namespace nested_enum
 
       if constexpr (flattenTuple)
       {
-        constexpr auto flattenedTuple = detail::tuple_of_arrays_to_array(detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>()));
+        constexpr auto flattenedTuple = flatten_recursive_internal<predicate, Selection>();
         return flattenedTuple;
       }
       else
       {
-        constexpr auto tuple = detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>());
+        constexpr auto tuple = return_recursive_internal<predicate, Selection>();
         return tuple;
       }
     }
     // returns std::tuple<std::array<std::optional<std::string_view>, ?>...> 
     // of the ids of all enum values in the subtree that satisfy the selection
     // if flattenTuple == true, the tuple of arrays will be flattened to a single array with all strings inside
-    template<InnerOuterAll Selection = All, bool flattenTuple = true>
+    template<InnerOuterAll Selection = All, bool flattenTuple = true> requires detail::hasIds<E>
     static constexpr auto enum_ids_recursive() noexcept
     {
       constexpr auto predicate = []<typename T>()
@@ -749,19 +1605,19 @@ namespace nested_enum
 
       if constexpr (flattenTuple)
       {
-        constexpr auto flattenedTuple = detail::tuple_of_arrays_to_array(detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>()));
+        constexpr auto flattenedTuple = flatten_recursive_internal<predicate, Selection>();
         return flattenedTuple;
       }
       else
       {
-        constexpr auto tuple = detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>());
+        constexpr auto tuple = return_recursive_internal<predicate, Selection>();
         return tuple;
       }
     }
     // returns std::tuple<std::array<std::pair<std::string_view, std::optional<std::string_view>>, ?>...>
     // of the ids and reflected strings of all enum values in the subtree that satisfy the selection
     // if flattenTuple == true, the tuple of arrays will be flattened to a single array with all pairs of strings inside
-    template<InnerOuterAll Selection = All, bool flattenTuple = true, bool clean = false>
+    template<InnerOuterAll Selection = All, bool flattenTuple = true, bool clean = false> requires detail::hasNames<E> && detail::hasIds<E>
     static constexpr auto enum_names_and_ids_recursive() noexcept
     {
       constexpr auto predicate = []<typename T>()
@@ -771,61 +1627,111 @@ namespace nested_enum
 
       if constexpr (flattenTuple)
       {
-        constexpr auto flattenedTuple = detail::tuple_of_arrays_to_array(detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>()));
+        constexpr auto flattenedTuple = flatten_recursive_internal<predicate, Selection>();
         return flattenedTuple;
       }
       else
       {
-        constexpr auto tuple = detail::tuple_magic::flatten(return_recursive_internal<predicate, Selection>());
+        constexpr auto tuple = return_recursive_internal<predicate, Selection>();
         return tuple;
       }
     }
 
+  private:
+    // static storage of the arrays the views below point into, only instantiated when a view is asked for
+    template<InnerOuterAll Selection>
+    static constexpr auto valuesStorage = enum_values<Selection>();
+    template<InnerOuterAll Selection, bool clean>
+    static constexpr auto namesStorage = enum_names<Selection>(clean);
+    template<InnerOuterAll Selection>
+    static constexpr auto idsStorage = enum_ids<Selection>();
+    template<bool clean>
+    static constexpr auto namesAndIdsStorage = enum_names_and_ids<All>(clean);
+    template<InnerOuterAll Selection, bool clean>
+    static constexpr auto namesRecursiveStorage = enum_names_recursive<Selection, true, clean>();
+    template<InnerOuterAll Selection>
+    static constexpr auto idsRecursiveStorage = enum_ids_recursive<Selection, true>();
+  public:
+    // the *_view functions return the same values as the functions they are named after
+    // as a std::span over static storage, so that nothing is copied when they are called or iterated over
+    template<InnerOuterAll Selection = All>
+    static constexpr auto enum_values_view() noexcept
+    {
+      return std::span{ valuesStorage<Selection> };
+    }
+    template<InnerOuterAll Selection = All> requires detail::hasNames<E>
+    static constexpr auto enum_names_view(bool clean = false) noexcept
+    {
+      return clean ? std::span{ namesStorage<Selection, true> } : std::span{ namesStorage<Selection, false> };
+    }
+    template<InnerOuterAll Selection = All> requires detail::hasIds<E>
+    static constexpr auto enum_ids_view() noexcept
+    {
+      return std::span{ idsStorage<Selection> };
+    }
+    // flattened like enum_names_recursive<Selection, true, clean>(), the position of every name
+    // of enum_names_recursive_view<All>() is the ordinal of its value (see tree_codec)
+    template<InnerOuterAll Selection = All, bool clean = false> requires detail::hasNames<E>
+    static constexpr auto enum_names_recursive_view() noexcept
+    {
+      return std::span{ namesRecursiveStorage<Selection, clean> };
+    }
+    template<InnerOuterAll Selection = All> requires detail::hasIds<E>
+    static constexpr auto enum_ids_recursive_view() noexcept
+    {
+      return std::span{ idsRecursiveStorage<Selection> };
+    }
+
     // returns the reflected string of an enum value of this type
-    static constexpr auto enum_name(E value, bool clean = false) -> std::optional<std::string_view>
+    static constexpr auto enum_name(E value, bool clean = false) -> std::optional<std::string_view> requires detail::hasNames<E>
     {
-      auto index = detail::find_index(E::enumValues, value.internalValue);
-      if (!index.has_value())
+      std::size_t position = detail::get_position<E>(value.internalValue);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_name, position != E::enumValues.size(), 0);
+      if (position == E::enumValues.size())
         return {};
 
-      return enum_names<All>(clean)[index.value()];
+      return enum_names_view<All>(clean)[position];
     }
     // returns the reflected string of an enum value of this type, specified by its id
-    static constexpr auto enum_name_by_id(std::string_view id, bool clean = false) -> std::optional<std::string_view>
+    static constexpr auto enum_name_by_id(std::string_view id, bool clean = false) -> std::optional<std::string_view> requires detail::hasNames<E> && detail::hasIds<E>
     {
-      auto index = detail::find_index(E::enumIds, id);
-      if (!index.has_value())
+      std::size_t position = detail::find_string<E, true>(id);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_name_by_id, position != E::enumValues.size(), detail::scanned_entries<E>(position));
+      if (position == E::enumValues.size())
         return {};
 
-      return enum_names(clean)[index.value()];
+      return enum_names_view<All>(clean)[position];
     }
     // returns the id of an enum value of this type
-    static constexpr auto enum_id(E value) -> std::optional<std::string_view>
+    static constexpr auto enum_id(E value) -> std::optional<std::string_view> requires detail::hasIds<E>
     {
       auto index = detail::find_index(E::enumValues, value.internalValue);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_id, index.has_value(),
+        (detail::scanned_entries<E, lookup_strategy::linear>(index.value_or(E::enumValues.size()))));
       if (!index.has_value())
         return {};
 
       return enum_ids<All>()[index.value()];
     }
     // returns the id of an enum value of this type, specified by its reflected string
-    static constexpr auto enum_id(std::string_view enumName) -> std::optional<std::string_view>
+    static constexpr auto enum_id(std::string_view enumName) -> std::optional<std::string_view> requires detail::hasNames<E> && detail::hasIds<E>
     {
-      constexpr auto strings = enum_names<All>();
-      auto index = detail::find_index(strings, enumName);
-      if (!index.has_value())
+      std::size_t position = detail::find_string<E, false>(enumName);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_id_by_name, position != E::enumValues.size(), detail::scanned_entries<E>(position));
+      if (position == E::enumValues.size())
         return {};
 
-      return enum_ids<All>()[index.value()];
+      return E::enumIds[position];
     }
     // returns the reflected string and id of an enum value of this type
-    static constexpr auto enum_name_and_id(E value, bool clean = false) -> std::optional<std::pair<std::string_view, std::optional<std::string_view>>>
+    static constexpr auto enum_name_and_id(E value, bool clean = false) -> std::optional<std::pair<std::string_view, std::optional<std::string_view>>> requires detail::hasNames<E> && detail::hasIds<E>
     {
-      auto index = detail::find_index(E::enumValues, value.internalValue);
-      if (!index.has_value())
+      std::size_t position = detail::get_position<E>(value.internalValue);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_name_and_id, position != E::enumValues.size(), 0);
+      if (position == E::enumValues.size())
         return {};
 
-      return enum_names_and_ids<All>(clean)[index.value()];
+      return clean ? namesAndIdsStorage<true>[position] : namesAndIdsStorage<false>[position];
     }
     // returns the underlying integer of an enum value of this type
     static constexpr auto enum_integer(E value)
@@ -833,23 +1739,24 @@ namespace nested_enum
       return std::optional{ (typename E::underlying_type)value.internalValue };
     }
     // returns the underlying integer of an enum value of this type, specified by its reflected string
-    static constexpr auto enum_integer(std::string_view enumName)
+    static constexpr auto enum_integer(std::string_view enumName) requires detail::hasNames<E>
     {
-      constexpr auto enumNames = enum_names<All>(false);
-      auto index = detail::find_index(enumNames, enumName);
-      if (!index.has_value())
+      std::size_t position = detail::find_string<E, false>(enumName);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_integer_by_name, position != E::enumValues.size(), detail::scanned_entries<E>(position));
+      if (position == E::enumValues.size())
         return std::optional<typename E::underlying_type>{};
 
-      return std::optional{ (typename E::underlying_type)E::enumValues[index.value()] };
+      return std::optional{ (typename E::underlying_type)E::enumValues[position] };
     }
     // returns the underlying integer of an enum value of this type, specified by its id
-    static constexpr auto enum_integer_by_id(std::string_view id)
+    static constexpr auto enum_integer_by_id(std::string_view id) requires detail::hasIds<E>
     {
-      auto index = detail::find_index(E::enumIds, id);
-      if (!index.has_value())
+      std::size_t position = detail::find_string<E, true>(id);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_integer_by_id, position != E::enumValues.size(), detail::scanned_entries<E>(position));
+      if (position == E::enumValues.size())
         return std::optional<typename E::underlying_type>{};
 
-      return std::optional{ (typename E::underlying_type)E::enumValues[index.value()] };
+      return std::optional{ (typename E::underlying_type)E::enumValues[position] };
     }
     // returns the enum value of this type, specified by an integer
     template<typename T> requires detail::this_underlying_type<T, E>
@@ -857,30 +1764,32 @@ namespace nested_enum
     {
       static_assert(std::is_same_v<T, typename E::underlying_type>);
 
-      for (auto value : E::enumValues)
-        if (value == (typename E::underlying_type)integer)
-          return std::optional<E>{ value };
+      std::size_t position = detail::get_position<E>(typename E::Value(integer));
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_value_by_integer, position != E::enumValues.size(), 0);
+      if (position == E::enumValues.size())
+        return std::optional<E>{};
 
-      return std::optional<E>{};
+      return std::optional<E>{ E::enumValues[position] };
     }
     // returns the enum value of this type, specified by its reflected string
-    static constexpr auto enum_value(std::string_view enumName)
+    static constexpr auto enum_value(std::string_view enumName) requires detail::hasNames<E>
     {
-      constexpr auto enumNames = enum_names<All>(false);
-      auto index = detail::find_index(enumNames, enumName);
-      if (!index.has_value())
+      std::size_t position = detail::find_string<E, false>(enumName);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_value_by_name, position != E::enumValues.size(), detail::scanned_entries<E>(position));
+      if (position == E::enumValues.size())
         return std::optional<E>{};
 
-      return std::optional<E>{ E::enumValues[index.value()] };
+      return std::optional<E>{ E::enumValues[position] };
     }
     // returns the enum value of this type, specified by its id
-    static constexpr auto enum_value_by_id(std::string_view id)
+    static constexpr auto enum_value_by_id(std::string_view id) requires detail::hasIds<E>
     {
-      auto index = detail::find_index(E::enumIds, id);
-      if (!index.has_value())
+      std::size_t position = detail::find_string<E, true>(id);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_value_by_id, position != E::enumValues.size(), detail::scanned_entries<E>(position));
+      if (position == E::enumValues.size())
         return std::optional<E>{};
 
-      return std::optional<E>{ E::enumValues[index.value()] };
+      return std::optional<E>{ E::enumValues[position] };
     }
   private:
     // predicate is a lambda that takes the current nested_enum struct as type template parameter and
@@ -932,258 +1841,1813 @@ namespace nested_enum
         }
       }
     }
-  public:
-    // returns the reflected string of an enum value that is located somewhere in the subtree
-    static constexpr auto enum_name_recursive(detail::Enum auto value, bool clean = false) -> std::optional<std::string_view>
+    // preorder layout of the values of all nodes in the subtree
+    static constexpr auto get_recursive_layout() noexcept
+    {
+      return []<typename ... Ts>(detail::type_list<Ts...>)
+      {
+        detail::recursive_layout<sizeof...(Ts), (Ts::enumValues.size() + ... + 0)> layout{};
+        std::size_t node = 0;
+        std::size_t position = 0;
+
+        auto addNode = [&]<typename T>()
+        {
+          layout.offsets[node] = position;
+          layout.subtreeEnds[node] = node + T::template get_nodes_recursive_internal<All>().size;
+          for (std::size_t i = 0; i < T::enumValues.size(); ++i, ++position)
+          {
+            layout.nodes[position] = node;
+            layout.entries[position] = i;
+          }
+          ++node;
+        };
+
+        (addNode.template operator()<Ts>(), ...);
+
+        return layout;
+      }(get_nodes_recursive_internal<All>());
+    }
+    // hashed index over the full names and aliases (or ids) of all values in the subtree
+    // built once for every enum that recursive lookups are made from
+    template<bool byId>
+    static constexpr auto recursiveIndex = []<typename ... Ts>(detail::type_list<Ts...>)
+    {
+      constexpr std::size_t aliases = byId ? 0 : (detail::aliasCount<Ts> + ... + 0);
+      detail::recursive_index<sizeof...(Ts), (Ts::enumValues.size() + ... + 0), (Ts::enumValues.size() + ... + 0) + aliases>
+        index{ get_recursive_layout() };
+      std::size_t position = 0;
+
+      auto addNode = [&]<typename T>()
+      {
+        constexpr auto enumNames = T::template enum_names<All>(false);
+        if constexpr (!byId)
+          for (std::size_t i = 0; i < detail::aliasCount<T>; ++i)
+            index.strings.insert(detail::aliasStrings<T, false>[i], position + detail::aliasNames<T>.positions[i]);
+
+        for (std::size_t i = 0; i < T::enumValues.size(); ++i, ++position)
+        {
+          if constexpr (byId)
+          {
+            if (T::enumIds[i].has_value())
+              index.strings.insert(T::enumIds[i].value(), position);
+          }
+          else
+            index.strings.insert(enumNames[i], position);
+        }
+      };
+
+      (addNode.template operator()<Ts>(), ...);
+
+      return index;
+    }(get_nodes_recursive_internal<All>());
+
+    template<bool byId, fixed_string string>
+    static constexpr auto find_recursive_internal() noexcept
+    {
+      constexpr auto result = recursiveIndex<byId>.find(std::string_view(string));
+
+    #if NESTED_ENUM_SUPPRESS_MULTIPLE_RESULTS_ASSERT == 0
+      static_assert(!result.isAmbiguous, "Multiple results found for query, if this is expected define NESTED_ENUM_SUPPRESS_MULTIPLE_RESULTS_ASSERT to 1 before including the header");
+    #endif
+
+      return result;
+    }
+  public:
+    // returns the reflected string of an enum value that is located somewhere in the subtree
+    static constexpr auto enum_name_recursive(detail::Enum auto value, bool clean = false) -> std::optional<std::string_view> requires detail::hasNames<E>
+    {
+      auto typeId = find_type_recursive_internal<[]<typename T>()
+      {
+        return std::is_same_v<decltype(value), typename T::Value>;
+      }>(E::subtypes);
+
+      if constexpr (typeId.size == 0)
+        return {};
+      else
+      {
+        using subType = decltype(detail::get_first_type(typeId));
+        return subType::enum_name(value, clean);
+      }
+    }
+  private:
+    // searched counts the enums the DFS went through
+    static constexpr auto enum_name_by_id_recursive_internal(std::string_view id, bool clean, std::size_t &searched) -> std::optional<std::string_view> requires detail::hasNames<E> && detail::hasIds<E>
+    {
+      // looked up directly rather than through enum_name_by_id so that only the recursive lookup is counted
+      ++searched;
+      std::size_t position = detail::find_string<E, true>(id);
+      if (position != E::enumValues.size())
+        return enum_names_view<All>(clean)[position];
+
+      if constexpr (E::enumValues.size() == 0)
+        return {};
+      else
+      {
+        return []<typename ... Ts>(std::string_view id, bool clean, std::size_t &searched, detail::type_list<Ts...>)
+        {
+          constexpr auto recurse = []<auto Self, typename U, typename ... Us>(std::string_view id, bool clean, std::size_t &searched)
+          {
+            auto value = U::enum_name_by_id_recursive_internal(id, clean, searched);
+            if (value.has_value())
+              return value;
+
+            if constexpr (sizeof...(Us) > 0)
+              return Self.template operator()<Self, Us...>(id, clean, searched);
+            else
+              return std::optional<std::string_view>{};
+          };
+
+          return recurse.template operator()<recurse, Ts...>(id, clean, searched);
+        }(id, clean, searched, E::subtypes);
+      }
+    }
+  public:
+    // returns the reflected string of an enum with the specified id that is located somewhere in the subtree
+    // the algorithm is a top-down DFS (in case you have repeating ids, which is not a good idea)
+    static constexpr auto enum_name_by_id_recursive(std::string_view id, bool clean = false) -> std::optional<std::string_view> requires detail::hasNames<E> && detail::hasIds<E>
+    {
+      std::size_t searched = 0;
+      auto value = enum_name_by_id_recursive_internal(id, clean, searched);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_name_by_id_recursive, value.has_value(), searched);
+      return value;
+    }
+    // returns the id of an enum value that is located somewhere in the subtree
+    static constexpr auto enum_id_recursive(detail::Enum auto value) -> std::optional<std::string_view> requires detail::hasIds<E>
+    {
+      auto typeId = find_type_recursive_internal<[]<typename T>()
+      {
+        return std::is_same_v<decltype(value), typename T::Value>;
+      }>(E::subtypes);
+
+      if constexpr (typeId.size == 0)
+        return {};
+      else
+      {
+        using subType = decltype(detail::get_first_type(typeId));
+        return subType::enum_id(value);
+      }
+    }
+  private:
+    // searched counts the enums the DFS went through
+    static constexpr auto enum_id_recursive_internal(std::string_view enumName, std::size_t &searched) -> std::optional<std::string_view> requires detail::hasNames<E> && detail::hasIds<E>
+    {
+      // looked up directly rather than through enum_id so that only the recursive lookup is counted
+      ++searched;
+      std::size_t position = detail::find_string<E, false>(enumName);
+      if (position != E::enumValues.size())
+        return E::enumIds[position];
+
+      if constexpr (E::enumValues.size() == 0)
+        return {};
+      else
+      {
+        return []<typename ... Ts>(std::string_view enumName, std::size_t &searched, detail::type_list<Ts...>)
+        {
+          constexpr auto recurse = []<auto Self, typename U, typename ... Us>(std::string_view enumName, std::size_t &searched)
+          {
+            auto value = U::enum_id_recursive_internal(enumName, searched);
+            if (value.has_value())
+              return value;
+
+            if constexpr (sizeof...(Us) > 0)
+              return Self.template operator()<Self, Us...>(enumName, searched);
+            else
+              return std::optional<std::string_view>{};
+          };
+
+          return recurse.template operator()<recurse, Ts...>(enumName, searched);
+        }(enumName, searched, E::subtypes);
+      }
+    }
+  public:
+    // returns the id of an enum with the specified reflected string that is located somewhere in the subtree
+    static constexpr auto enum_id_recursive(std::string_view enumName) -> std::optional<std::string_view> requires detail::hasNames<E> && detail::hasIds<E>
+    {
+      std::size_t searched = 0;
+      auto value = enum_id_recursive_internal(enumName, searched);
+      NESTED_ENUM_INTERNAL_COUNT_LOOKUP(E, enum_id_by_name_recursive, value.has_value(), searched);
+      return value;
+    }
+    // returns the underlying integer of an enum value that is located somewhere in the subtree, specified by its reflected string
+    // make sure to provide the full enum name to avoid erroneous results
+    template<fixed_string enumName> requires detail::hasNames<E>
+    static constexpr auto enum_integer_recursive()
+    {
+      constexpr auto result = find_recursive_internal<false, enumName>();
+
+      if constexpr (!result.isFound)
+        return std::optional<typename E::underlying_type>{};
+      else
+      {
+        using subType = typename decltype(detail::get_type_at<result.node>(get_nodes_recursive_internal<All>()))::type;
+        return std::optional{ (typename subType::underlying_type)subType::enumValues[result.entry] };
+      }
+    }
+    // returns the underlying integer of an enum value that is located somewhere in the subtree, specified by its id
+    template<fixed_string id> requires detail::hasIds<E>
+    static constexpr auto enum_integer_by_id_recursive()
+    {
+      constexpr auto result = find_recursive_internal<true, id>();
+
+      if constexpr (!result.isFound)
+        return std::optional<typename E::underlying_type>{};
+      else
+      {
+        using subType = typename decltype(detail::get_type_at<result.node>(get_nodes_recursive_internal<All>()))::type;
+        return std::optional{ (typename subType::underlying_type)subType::enumValues[result.entry] };
+      }
+    }
+    // returns an enum value that is located somewhere in the subtree, specified by its reflected string
+    template<fixed_string enumName> requires detail::hasNames<E>
+    static constexpr auto enum_value_recursive()
+    {
+      constexpr auto result = find_recursive_internal<false, enumName>();
+
+      if constexpr (!result.isFound)
+        return std::optional<E>{};
+      else
+      {
+        using subType = typename decltype(detail::get_type_at<result.node>(get_nodes_recursive_internal<All>()))::type;
+        return std::optional<subType>{ subType::enumValues[result.entry] };
+      }
+    }
+    // returns an enum value that is located somewhere in the subtree, specified by its id
+    template<fixed_string id> requires detail::hasIds<E>
+    static constexpr auto enum_value_by_id_recursive()
+    {
+      constexpr auto result = find_recursive_internal<true, id>();
+
+      if constexpr (!result.isFound)
+        return std::optional<E>{};
+      else
+      {
+        using subType = typename decltype(detail::get_type_at<result.node>(get_nodes_recursive_internal<All>()))::type;
+        return std::optional<subType>{ subType::enumValues[result.entry] };
+      }
+    }
+  };
+
+  template<class E>
+  concept NestedEnum = requires { typename E::nested_enum_tag; };
+
+  // helper function for doing recursive iteration over types with enum_subtypes()
+  // it is intended for expanding branches without needing to write them manually
+  // 1st template parameter is the lambda itself and consequent template parameters are the deduced types
+  // Example:
+  // 
+  // template<nested_enum::NestedEnum T>
+  // void do_thing(T value)
+  // {
+  //   nested_enum::recurse_over_types<[]<auto Self, typename U, typename ... Us>(T value)
+  //     {
+  //       if constexpr (std::is_same_v<decltype(U::value()), T>)
+  //         if (U::value() == value)
+  //           do_something_else<typename U::linked_type>();
+  //       
+  //       if constexpr (sizeof...(Us) > 0)
+  //         Self.template operator()<Self, Us...>(value);
+  //       else
+  //       {
+  //         // Uncaught case
+  //         assert(false);
+  //       }
+  //     }>(SomeEnum::enum_subtypes(), value);
+  // }
+  //
+  // keep in mind that as of C++20 only captureless lambdas can be used as non-type template parameters
+  // any extra parameters can be passed in as a parameter pack
+  template<auto Lambda, typename ... Ts, typename ... Args>
+  constexpr auto recurse_over_types(const std::tuple<std::type_identity<Ts>...> &, Args&& ... args)
+  {
+    return Lambda.template operator()<Lambda, Ts...>(std::forward<Args>(args)...);
+  }
+
+  template <typename E, typename P>
+  constexpr bool operator==(const nested_enum<E, P> &left, const nested_enum<E, P> &right) noexcept
+  {
+    return static_cast<const E &>(left).internalValue == static_cast<const E &>(right).internalValue;
+  }
+
+  template <typename E, typename P>
+  constexpr bool operator==(const nested_enum<E, P> &left, const typename E::Value &right) noexcept
+  {
+    return static_cast<const E &>(left).internalValue == right;
+  }
+
+  template <typename E, typename P>
+  constexpr bool operator==(const typename E::Value &left, const nested_enum<E, P> &right) noexcept
+  {
+    return left == static_cast<const E &>(right).internalValue;
+  }
+
+  // values of the same enum are ordered by their declaration, so sorting tree_codec<E>::value_type sorts by ordinal
+  template <typename E, typename P>
+  constexpr auto operator<=>(const nested_enum<E, P> &left, const nested_enum<E, P> &right) noexcept
+  {
+    return detail::get_ordering_key<E>(static_cast<const E &>(left).internalValue) <=>
+      detail::get_ordering_key<E>(static_cast<const E &>(right).internalValue);
+  }
+
+  template <typename E, typename P>
+  constexpr auto operator<=>(const nested_enum<E, P> &left, const typename E::Value &right) noexcept
+  {
+    return detail::get_ordering_key<E>(static_cast<const E &>(left).internalValue) <=> detail::get_ordering_key<E>(right);
+  }
+
+  // binary codec for the values anywhere in the tree of E
+  // every value is identified by its ordinal, the position its name has in E::enum_names_recursive<All>()
+  // (nodes in preorder, values of a node in declaration order), which is written as an unsigned LEB128 varint
+  template<typename E>
+  struct tree_codec
+  {
+    static_assert(NestedEnum<E>);
+
+  private:
+    static constexpr auto nodes = E::template get_nodes_recursive_internal<All>();
+    static constexpr auto layout = E::get_recursive_layout();
+
+    template<typename ... Ts>
+    static auto get_variant(detail::type_list<Ts...>) -> std::variant<std::monostate, Ts...>;
+
+    template<typename V, typename ... Ts>
+    static constexpr std::size_t get_node_index(detail::type_list<Ts...>) noexcept
+    {
+      std::size_t index = 0;
+      (void)((!std::is_same_v<V, typename Ts::Value> && ++index) && ...);
+      return index;
+    }
+
+  public:
+    // std::monostate stands for a value that isn't part of the tree
+    using value_type = decltype(get_variant(nodes));
+    // number of values in the tree
+    static constexpr std::size_t size = layout.nodes.size();
+    // the most bytes a single encoded value takes up
+    static constexpr std::size_t maxEncodedSize = []()
+    {
+      std::size_t bytes = 1;
+      for (std::size_t ordinal = (size > 0) ? size - 1 : 0; ordinal >= 0x80; ordinal >>= 7)
+        ++bytes;
+      return bytes;
+    }();
+
+    // changes whenever the structure, the names, the integer values or the ids of the tree change
+    // so that peers can check if they were built from the same version of it
+    static constexpr std::uint64_t fingerprint = []<typename ... Ts>(detail::type_list<Ts...>)
+    {
+      std::uint64_t hash = detail::hash_string("");
+      std::size_t node = 0;
+
+      auto addString = [&](std::string_view string)
+      {
+        hash = detail::hash_integer(string.size(), hash);
+        hash = detail::hash_string(string, hash);
+      };
+
+      auto addNode = [&]<typename T>()
+      {
+        using underlying = typename T::underlying_type;
+        hash = detail::hash_integer(sizeof(underlying) * 2 + std::is_signed_v<underlying>, hash);
+        hash = detail::hash_integer(T::enumValues.size(), hash);
+        hash = detail::hash_integer(layout.subtreeEnds[node] - node, hash);
+        ++node;
+
+        // names of all values, separated by null terminators
+        if constexpr (detail::hasNames<E>)
+        {
+          addString(T::internalName);
+          addString(T::enumNames);
+        }
+
+        for (std::size_t i = 0; i < T::enumValues.size(); ++i)
+        {
+          hash = detail::hash_integer((std::uint64_t)(underlying)T::enumValues[i], hash);
+
+          if constexpr (detail::hasIds<E>)
+          {
+            hash = detail::hash_integer(T::enumIds[i].has_value(), hash);
+            if (T::enumIds[i].has_value())
+              addString(T::enumIds[i].value());
+          }
+        }
+      };
+
+      (addNode.template operator()<Ts>(), ...);
+
+      return hash;
+    }(nodes);
+
+  private:
+    // constructs the value of every node from its position inside the node
+    static constexpr auto valueMakers = []<typename ... Ts>(detail::type_list<Ts...>)
+    {
+      return []<std::size_t ... Is>(std::index_sequence<Is...>)
+      {
+        return std::array<value_type (*)(std::size_t), sizeof...(Ts)>{ [](std::size_t entry) -> value_type
+          {
+            return value_type{ std::in_place_index<Is + 1>, Ts{ Ts::enumValues[entry] } };
+          }... };
+      }(std::index_sequence_for<Ts...>{});
+    }(nodes);
+
+  public:
+    // returns the ordinal of a value that is located somewhere in the tree
+    template<detail::Enum V>
+    static constexpr auto ordinal(V value) noexcept -> std::optional<std::size_t>
+    {
+      constexpr std::size_t node = get_node_index<V>(nodes);
+      if constexpr (node == nodes.size)
+        return {};
+      else
+      {
+        using T = typename decltype(detail::get_type_at<node>(nodes))::type;
+
+        std::size_t entry = detail::get_position<T>(value);
+        if (entry == T::enumValues.size())
+          return {};
+
+        return layout.offsets[node] + entry;
+      }
+    }
+    static constexpr auto ordinal(NestedEnum auto value) noexcept -> std::optional<std::size_t>
+    {
+      return ordinal(value.internalValue);
+    }
+    static constexpr auto ordinal(const value_type &value) -> std::optional<std::size_t>
+    {
+      return std::visit([]<typename T>(const T &alternative) -> std::optional<std::size_t>
+        {
+          if constexpr (std::is_same_v<T, std::monostate>)
+            return {};
+          else
+            return ordinal(alternative.internalValue);
+        }, value);
+    }
+    // returns the value with the given ordinal, or std::monostate if there is none
+    static constexpr auto value(std::size_t ordinal) -> value_type
+    {
+      if (ordinal >= size)
+        return {};
+
+      return valueMakers[layout.nodes[ordinal]](layout.entries[ordinal]);
+    }
+    // ordinal of the ancestor at the given depth of every value, values that aren't as deep map to themselves
+    // values of E are at depth 0, values of its subtypes at depth 1 and so on
+    template<std::size_t Depth>
+    static constexpr auto ancestors = []()
+    {
+      // depth of every node and the ordinal of the value it is the subtype of
+      std::array<std::size_t, nodes.size> depths{};
+      std::array<std::size_t, nodes.size> parents{};
+      [&]<typename ... Ts>(detail::type_list<Ts...>)
+      {
+        std::size_t node = 0;
+        auto addNode = [&]<typename T>()
+        {
+          if constexpr (!std::is_same_v<T, E>)
+          {
+            parents[node] = ordinal(T::value()).value();
+            depths[node] = depths[layout.nodes[parents[node]]] + 1;
+          }
+          ++node;
+        };
+
+        (addNode.template operator()<Ts>(), ...);
+      }(nodes);
+
+      std::array<std::size_t, size> result{};
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        std::size_t current = i;
+        while (depths[layout.nodes[current]] > Depth)
+          current = parents[layout.nodes[current]];
+        result[i] = current;
+      }
+      return result;
+    }();
+
+    // returns the ordinal of the value with the given full name
+    static constexpr auto ordinal_by_name(std::string_view name) -> std::optional<std::size_t> requires detail::hasNames<E>
+    {
+      std::size_t result = size;
+      E::template recursiveIndex<false>.strings.find(name, [&](std::size_t position)
+        { result = (position < result) ? position : result; });
+
+      if (result == size)
+        return {};
+      return result;
+    }
+    // fills remap with the ordinal in this version of the tree of every value of another version, given that version's
+    // E::enum_names_recursive<All>(), values that don't exist anymore are mapped to size
+    // returns false if remap doesn't have space for all names
+    static constexpr bool make_remap(std::span<const std::string_view> names, std::span<std::size_t> remap) requires detail::hasNames<E>
+    {
+      if (remap.size() < names.size())
+        return false;
+
+      for (std::size_t i = 0; i < names.size(); ++i)
+        remap[i] = ordinal_by_name(names[i]).value_or(size);
+
+      return true;
+    }
+
+    // writes a single value to the start of the buffer and returns the number of bytes written
+    // returns 0 if the value isn't part of the tree or the buffer is too small
+    template<typename V> requires detail::Enum<V> || NestedEnum<V> || std::is_same_v<V, value_type>
+    static constexpr auto encode(const V &value, std::span<std::uint8_t> buffer) -> std::size_t
+    {
+      auto position = ordinal(value);
+      if (!position.has_value())
+        return 0;
+
+      return detail::write_varint(position.value(), buffer);
+    }
+    // reads a single value from the start of the buffer and returns it together with the number of bytes read
+    // returns std::monostate and 0 if the buffer doesn't start with a value of the tree
+    static constexpr auto decode(std::span<const std::uint8_t> buffer) -> std::pair<value_type, std::size_t>
+    {
+      auto [position, bytes] = detail::read_varint(buffer.first(buffer.size() < maxEncodedSize ? buffer.size() : maxEncodedSize));
+      if (bytes == 0 || position >= size)
+        return { value_type{}, 0 };
+
+      return { value((std::size_t)position), bytes };
+    }
+    // same as decode but for bytes encoded by another version of the tree, with remap from make_remap
+    static constexpr auto decode_remapped(std::span<const std::uint8_t> buffer, std::span<const std::size_t> remap) -> std::pair<value_type, std::size_t>
+    {
+      auto [position, bytes] = detail::read_varint(buffer);
+      if (bytes == 0 || position >= remap.size() || remap[position] >= size)
+        return { value_type{}, 0 };
+
+      return { value(remap[position]), bytes };
+    }
+    // writes the values one after another and returns the number of bytes written
+    // returns std::nullopt if any of the values isn't part of the tree or the buffer is too small
+    static constexpr auto encode(std::span<const value_type> values, std::span<std::uint8_t> buffer) -> std::optional<std::size_t>
+    {
+      std::size_t bytes = 0;
+      for (const auto &value : values)
+      {
+        std::size_t written = encode(value, buffer.subspan(bytes));
+        if (written == 0)
+          return {};
+        bytes += written;
+      }
+
+      return bytes;
+    }
+    // reads values until the end of the buffer and returns how many were read
+    // returns std::nullopt if the buffer contains anything but values of the tree or there isn't enough space for all of them
+    static constexpr auto decode(std::span<const std::uint8_t> buffer, std::span<value_type> values) -> std::optional<std::size_t>
+    {
+      std::size_t count = 0;
+      for (std::size_t bytes = 0; bytes < buffer.size(); ++count)
+      {
+        if (count == values.size())
+          return {};
+
+        auto [value, read] = decode(buffer.subspan(bytes));
+        if (read == 0)
+          return {};
+
+        values[count] = std::move(value);
+        bytes += read;
+      }
+
+      return count;
+    }
+  };
+
+  namespace detail
+  {
+    template<typename T, std::size_t N>
+    constexpr auto as_tuple(const std::array<T, N> &array) noexcept { return std::tuple{ array }; }
+    template<typename ... Ts>
+    constexpr auto as_tuple(const std::tuple<Ts...> &tuple) noexcept { return tuple; }
+
+    // ordinals (see tree_codec) of the values anywhere in the tree of E that satisfy the selection,
+    // every ordinal is selected for All so nothing is stored for it
+    template<typename E, InnerOuterAll Selection>
+    inline constexpr auto selectedOrdinals = []()
+    {
+      if constexpr (Selection == All)
+        return std::array<std::size_t, 0>{};
+      else
+      {
+        constexpr auto arrays = as_tuple(E::template enum_values_recursive<Selection>());
+        constexpr std::size_t count = []<typename ... Ts>(std::type_identity<std::tuple<Ts...>>)
+        {
+          return (std::tuple_size_v<Ts> + ... + 0);
+        }(std::type_identity<std::remove_const_t<decltype(arrays)>>{});
+
+        std::array<std::size_t, count> result{};
+        std::size_t index = 0;
+        std::apply([&](const auto &... array)
+          {
+            auto append = [&](const auto &values)
+            {
+              for (auto value : values)
+                result[index++] = tree_codec<E>::ordinal(value).value();
+            };
+            (append(array), ...);
+          }, arrays);
+        return result;
+      }
+    }();
+  }
+
+  // lazy range over the values anywhere in the tree of E that satisfy the selection, in the order of their ordinals
+  // (see tree_codec), a value is only constructed when its iterator is dereferenced
+  template<NestedEnum E, InnerOuterAll Selection = All>
+  class tree_view
+  {
+    using codec = tree_codec<E>;
+
+    static constexpr auto &ordinals = detail::selectedOrdinals<E, Selection>;
+
+  public:
+    using value_type = typename codec::value_type;
+
+    static constexpr std::size_t size() noexcept { return (Selection == All) ? codec::size : ordinals.size(); }
+    static constexpr bool empty() noexcept { return size() == 0; }
+
+    struct iterator
+    {
+      using value_type = typename tree_view::value_type;
+      using difference_type = std::ptrdiff_t;
+
+      constexpr auto operator*() const { return codec::value(ordinal()); }
+      constexpr iterator &operator++() noexcept { ++index; return *this; }
+      constexpr iterator operator++(int) noexcept { auto copy = *this; ++index; return copy; }
+      constexpr bool operator==(const iterator &) const noexcept = default;
+
+      // ordinal of the value the iterator points to
+      constexpr std::size_t ordinal() const noexcept
+      {
+        if constexpr (Selection == All)
+          return index;
+        else
+          return ordinals[index];
+      }
+
+      std::size_t index = 0;
+    };
+
+    constexpr auto begin() const noexcept { return iterator{ 0 }; }
+    constexpr auto end() const noexcept { return iterator{ size() }; }
+  };
+
+  // compile-time properties of the integers of the values of E
+  template<NestedEnum E>
+  struct enum_traits
+  {
+    using underlying_type = typename E::underlying_type;
+
+    static constexpr std::size_t size = E::enumValues.size();
+    static constexpr underlying_type min_value = (size > 0) ? (underlying_type)detail::sortedValues<E>.values[0] : 0;
+    static constexpr underlying_type max_value = (size > 0) ? (underlying_type)detail::sortedValues<E>.values[size - 1] : 0;
+    // whether the integers are exactly the range [min_value, max_value] without repeats
+    static constexpr bool is_contiguous = []()
+    {
+      for (std::size_t i = 1; i < size; ++i)
+        if ((underlying_type)detail::sortedValues<E>.values[i] != (underlying_type)detail::sortedValues<E>.values[i - 1] + 1)
+          return false;
+      return true;
+    }();
+    // bits needed to store the position of any value in the declaration order, at least 1
+    static constexpr std::size_t bits_required = (size > 2) ? std::bit_width(size - 1) : 1;
+  };
+
+  // vector of values of E that stores every value as its position in the declaration order of E
+  // in enum_traits<E>::bits_required bits, values never straddle two 64 bit words
+  template<NestedEnum E>
+  class packed_enum_vector
+  {
+  public:
+    using value_type = E;
+    static constexpr std::size_t bits = enum_traits<E>::bits_required;
+    static constexpr std::size_t valuesPerWord = 64 / bits;
+
+    packed_enum_vector() = default;
+    // n copies of value, or an empty vector if value isn't part of E
+    packed_enum_vector(std::size_t n, typename E::Value value) { resize(n, value); }
+
+    std::size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    // bytes taken up by the packed values
+    std::size_t memory_size() const noexcept { return words.size() * sizeof(std::uint64_t); }
+    void reserve(std::size_t n) { words.reserve((n + valuesPerWord - 1) / valuesPerWord); }
+    void clear() noexcept { words.clear(); count = 0; }
+
+    E operator[](std::size_t index) const noexcept
+    {
+      auto position = (words[index / valuesPerWord] >> (index % valuesPerWord * bits)) & mask;
+      return E{ E::enumValues[position] };
+    }
+    // returns false if value isn't part of E
+    bool set(std::size_t index, typename E::Value value) noexcept
+    {
+      std::size_t position = detail::get_position<E>(value);
+      if (position == E::enumValues.size())
+        return false;
+
+      auto &word = words[index / valuesPerWord];
+      std::size_t shift = index % valuesPerWord * bits;
+      word = (word & ~(mask << shift)) | ((std::uint64_t)position << shift);
+      return true;
+    }
+    // returns false if value isn't part of E
+    bool push_back(typename E::Value value)
+    {
+      if (detail::get_position<E>(value) == E::enumValues.size())
+        return false;
+
+      if (count % valuesPerWord == 0)
+        words.push_back(0);
+      return set(count++, value);
+    }
+    // new values are copies of value, returns false if value isn't part of E and leaves the vector as is
+    bool resize(std::size_t n, typename E::Value value)
+    {
+      std::size_t position = detail::get_position<E>(value);
+      if (position == E::enumValues.size())
+        return false;
+
+      std::size_t oldCount = count;
+      words.resize((n + valuesPerWord - 1) / valuesPerWord, repeat(position));
+      count = n;
+      // the last word that was already there is only partially filled
+      for (std::size_t i = oldCount; i < n && i % valuesPerWord != 0; ++i)
+        set(i, value);
+      return true;
+    }
+
+    // appends all values of input, returns false if any of them isn't part of E and leaves the vector as is
+    bool pack(std::span<const typename E::Value> input)
+    {
+      std::size_t oldCount = count;
+      reserve(count + input.size());
+      for (auto value : input)
+        if (!push_back(value))
+        {
+          count = oldCount;
+          words.resize((count + valuesPerWord - 1) / valuesPerWord);
+          return false;
+        }
+      return true;
+    }
+    // writes the values from first on into output, one word at a time
+    // returns how many values were written, which is limited by the size of output
+    std::size_t unpack(std::span<typename E::Value> output, std::size_t first = 0) const noexcept
+    {
+      std::size_t last = (first < count) ? ((count - first < output.size()) ? count : first + output.size()) : first;
+      std::size_t index = first;
+      while (index < last)
+      {
+        std::uint64_t word = words[index / valuesPerWord] >> (index % valuesPerWord * bits);
+        std::size_t wordEnd = (index / valuesPerWord + 1) * valuesPerWord;
+        for (std::size_t end = (wordEnd < last) ? wordEnd : last; index < end; ++index, word >>= bits)
+          output[index - first] = E::enumValues[word & mask];
+      }
+      return last - first;
+    }
+
+    struct iterator
+    {
+      using value_type = E;
+      using difference_type = std::ptrdiff_t;
+
+      E operator*() const noexcept { return (*vector)[index]; }
+      iterator &operator++() noexcept { ++index; return *this; }
+      iterator operator++(int) noexcept { auto copy = *this; ++index; return copy; }
+      bool operator==(const iterator &) const noexcept = default;
+
+      const packed_enum_vector *vector = nullptr;
+      std::size_t index = 0;
+    };
+
+    auto begin() const noexcept { return iterator{ this, 0 }; }
+    auto end() const noexcept { return iterator{ this, count }; }
+
+  private:
+    static constexpr std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+
+    // a word that holds position in every slot
+    static constexpr std::uint64_t repeat(std::size_t position) noexcept
+    {
+      std::uint64_t word = 0;
+      for (std::size_t i = 0; i < valuesPerWord; ++i)
+        word |= (std::uint64_t)position << (i * bits);
+      return word;
+    }
+
+    std::vector<std::uint64_t> words{};
+    std::size_t count = 0;
+  };
+
+  // column of values from the tree of E in a binary format that can be read in place, laid out as
+  //   header   - "NECOLUMN", version, fingerprint, number of values, bytes per ordinal, number of names, bytes of names
+  //              as little endian integers of 4, 8, 8, 4, 8 and 8 bytes
+  //   names    - E::enum_names_recursive<All>() joined by null terminators, empty if names were left out
+  //   ordinals - little endian ordinals of the values (see tree_codec)
+  // writing and reading only works on bytes, mapping a file into memory is left to the caller
+  template<typename E>
+  class column_view
+  {
+    static_assert(NestedEnum<E>);
+    using codec = tree_codec<E>;
+
+  public:
+    using value_type = typename codec::value_type;
+
+    static constexpr std::string_view magic = "NECOLUMN";
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t headerSize = 48;
+    // bytes per ordinal in columns written by this version of the tree
+    static constexpr std::size_t ordinalSize = (codec::size <= 0x100) ? 1 : (codec::size <= 0x10000) ? 2 : 4;
+
+  private:
+    static constexpr auto get_names() noexcept
+    {
+      if constexpr (detail::hasNames<E>)
+        return E::template enum_names_recursive<All>();
+      else
+        return std::array<std::string_view, 0>{};
+    }
+
+    static constexpr std::size_t namesSize = []()
+    {
+      std::size_t result = 0;
+      for (auto name : get_names())
+        result += name.size() + 1;
+      return result;
+    }();
+
+  public:
+    // number of bytes needed to write a column of count values
+    static constexpr std::size_t bytes_needed(std::size_t count) noexcept { return headerSize + namesSize + count * ordinalSize; }
+
+    // writes the projected values as a column and returns the number of bytes written
+    // projection returns anything tree_codec<E>::ordinal accepts
+    // returns nothing if any of the values isn't part of the tree or the buffer is too small
+    template<typename Projection = std::identity>
+    static constexpr auto write(const auto &values, std::span<std::uint8_t> buffer, Projection projection = {}) -> std::optional<std::size_t>
+    {
+      std::size_t count = 0;
+      for ([[maybe_unused]] const auto &value : values)
+        ++count;
+
+      std::size_t bytes = bytes_needed(count);
+      if (buffer.size() < bytes)
+        return {};
+
+      std::uint8_t *data = buffer.data();
+      for (char c : magic)
+        *data++ = (std::uint8_t)c;
+      detail::write_little_endian(version, 4, data);
+      detail::write_little_endian(codec::fingerprint, 8, data + 4);
+      detail::write_little_endian(count, 8, data + 12);
+      detail::write_little_endian(ordinalSize, 4, data + 20);
+      detail::write_little_endian(get_names().size(), 8, data + 24);
+      detail::write_little_endian(namesSize, 8, data + 32);
+      data += headerSize - magic.size();
+
+      for (auto name : get_names())
+      {
+        for (char c : name)
+          *data++ = (std::uint8_t)c;
+        *data++ = 0;
+      }
+
+      for (const auto &value : values)
+      {
+        auto ordinal = codec::ordinal(std::invoke(projection, value));
+        if (!ordinal.has_value())
+          return {};
+
+        detail::write_little_endian(ordinal.value(), ordinalSize, data);
+        data += ordinalSize;
+      }
+
+      return bytes;
+    }
+
+    // checks the header and returns a view of the column, or nothing if the bytes don't hold a whole column
+    static constexpr auto open(std::span<const std::uint8_t> bytes) noexcept -> std::optional<column_view>
+    {
+      if (bytes.size() < headerSize)
+        return {};
+
+      for (std::size_t i = 0; i < magic.size(); ++i)
+        if (bytes[i] != (std::uint8_t)magic[i])
+          return {};
+
+      const std::uint8_t *data = bytes.data() + magic.size();
+      if (detail::read_little_endian(data, 4) != version)
+        return {};
+
+      column_view view{};
+      view.storedFingerprint = detail::read_little_endian(data + 4, 8);
+      std::uint64_t count = detail::read_little_endian(data + 12, 8);
+      std::uint64_t width = detail::read_little_endian(data + 20, 4);
+      view.nameCount = detail::read_little_endian(data + 24, 8);
+      std::uint64_t nameBytes = detail::read_little_endian(data + 32, 8);
+
+      if (width != 1 && width != 2 && width != 4)
+        return {};
+      if (nameBytes > bytes.size() - headerSize || count > (bytes.size() - headerSize - nameBytes) / width)
+        return {};
+      // every name takes up at least its terminator
+      if (view.nameCount > nameBytes || (nameBytes > 0 && bytes[headerSize + nameBytes - 1] != 0))
+        return {};
+
+      view.nameBytes = bytes.subspan(headerSize, nameBytes);
+      view.ordinalBytes = bytes.subspan(headerSize + nameBytes, count * width);
+      view.width = width;
+      view.count = count;
+      return view;
+    }
+
+    // number of values in the column
+    constexpr std::size_t size() const noexcept { return count; }
+    constexpr bool empty() const noexcept { return count == 0; }
+    // fingerprint of the tree that the column was written with
+    constexpr std::uint64_t fingerprint() const noexcept { return storedFingerprint; }
+    // whether the column was written with this version of the tree, if not values can only be read after use_remap
+    constexpr bool is_current() const noexcept { return storedFingerprint == codec::fingerprint; }
+
+    // returns the ordinal stored at the given position, in the tree the column was written with
+    constexpr std::size_t stored_ordinal(std::size_t index) const noexcept
+    {
+      const std::uint8_t *data = ordinalBytes.data() + index * width;
+      switch (width)
+      {
+      case 1:
+        return data[0];
+      case 2:
+        return (std::size_t)detail::read_little_endian(data, 2);
+      default:
+        return (std::size_t)detail::read_little_endian(data, 4);
+      }
+    }
+    // returns the value at the given position, or std::monostate if it doesn't exist in this version of the tree
+    constexpr auto operator[](std::size_t index) const -> value_type
+    {
+      std::size_t ordinal = stored_ordinal(index);
+      if (!remap.empty())
+        ordinal = (ordinal < remap.size()) ? remap[ordinal] : codec::size;
+      else if (!is_current())
+        return {};
+
+      return codec::value(ordinal);
+    }
+
+    // fills remap with the ordinals in this version of the tree for the names stored in the column
+    // returns false if remap doesn't have space for all of them
+    bool make_remap(std::span<std::size_t> remap) const requires detail::hasNames<E>
+    {
+      if (remap.size() < nameCount)
+        return false;
+
+      std::string_view names{ (const char *)nameBytes.data(), nameBytes.size() };
+      std::size_t offset = 0;
+      for (std::size_t i = 0; i < nameCount; ++i)
+      {
+        if (offset >= names.size())
+          return false;
+        remap[i] = codec::ordinal_by_name(detail::get_next_substring(names, offset, false)).value_or(codec::size);
+      }
+
+      return true;
+    }
+    // translates values stored by another version of the tree through a remap from make_remap
+    // remap needs to outlive the view
+    constexpr void use_remap(std::span<const std::size_t> newRemap) noexcept { remap = newRemap; }
+
+    struct iterator
+    {
+      using value_type = typename column_view::value_type;
+      using difference_type = std::ptrdiff_t;
+
+      constexpr auto operator*() const { return (*view)[index]; }
+      constexpr iterator &operator++() noexcept { ++index; return *this; }
+      constexpr iterator operator++(int) noexcept { auto copy = *this; ++index; return copy; }
+      constexpr bool operator==(const iterator &) const noexcept = default;
+
+      const column_view *view = nullptr;
+      std::size_t index = 0;
+    };
+
+    constexpr auto begin() const noexcept { return iterator{ this, 0 }; }
+    constexpr auto end() const noexcept { return iterator{ this, count }; }
+
+  private:
+    std::span<const std::uint8_t> nameBytes{};
+    std::span<const std::uint8_t> ordinalBytes{};
+    std::span<const std::size_t> remap{};
+    std::uint64_t storedFingerprint = 0;
+    std::size_t nameCount = 0;
+    std::size_t count = 0;
+    std::size_t width = 1;
+  };
+
+  // stably sorts input into output by the projected values of E in declaration order, in two linear passes
+  // projection returns either E or E::Value, values that aren't part of E end up last
+  // returns false if output is smaller than input
+  template<NestedEnum E, typename Projection = std::identity>
+  constexpr bool counting_sort(const auto &input, auto &&output, Projection projection = {})
+  {
+    auto key = [&](const auto &element) { return detail::get_position<E>(typename E::Value(std::invoke(projection, element))); };
+    return detail::bucket_sort<E::enumValues.size() + 1>(input, std::span{ output }, key).has_value();
+  }
+
+  // groups input into output the same way as counting_sort
+  // returns the group of every value of E in declaration order as views into output, or nothing if output is smaller than input
+  template<NestedEnum E, typename Projection = std::identity>
+  constexpr auto group_by(const auto &input, auto &&output, Projection projection = {})
+  {
+    std::span outputSpan{ output };
+    using element_type = typename decltype(outputSpan)::element_type;
+    using result_type = std::optional<std::array<std::span<element_type>, E::enumValues.size()>>;
+
+    auto key = [&](const auto &element) { return detail::get_position<E>(typename E::Value(std::invoke(projection, element))); };
+    auto offsets = detail::bucket_sort<E::enumValues.size() + 1>(input, std::span<element_type>{ outputSpan }, key);
+    if (!offsets.has_value())
+      return result_type{};
+
+    return result_type{ detail::get_groups<E::enumValues.size()>(std::span<element_type>{ outputSpan }, offsets.value()) };
+  }
+
+  // stably sorts input into output by the ordinals in the tree of E of the projected values
+  // projection returns anything tree_codec<E>::ordinal accepts, values that aren't part of the tree end up last
+  // returns false if output is smaller than input
+  template<NestedEnum E, typename Projection = std::identity>
+  constexpr bool counting_sort_recursive(const auto &input, auto &&output, Projection projection = {})
+  {
+    using codec = tree_codec<E>;
+    auto key = [&](const auto &element) { return codec::ordinal(std::invoke(projection, element)).value_or(codec::size); };
+    return detail::bucket_sort<codec::size + 1>(input, std::span{ output }, key).has_value();
+  }
+
+  // groups input into output by the ancestors at the given depth of the projected values (see tree_codec<E>::ancestors)
+  // returns a view into output for every ordinal of the tree, groups of values deeper than Depth are empty
+  // and their elements are in the groups of their ancestors, or nothing if output is smaller than input
+  template<NestedEnum E, std::size_t Depth = std::size_t(-1), typename Projection = std::identity>
+  constexpr auto group_by_recursive(const auto &input, auto &&output, Projection projection = {})
+  {
+    using codec = tree_codec<E>;
+    std::span outputSpan{ output };
+    using element_type = typename decltype(outputSpan)::element_type;
+    using result_type = std::optional<std::array<std::span<element_type>, codec::size>>;
+
+    auto key = [&](const auto &element)
+    {
+      std::size_t ordinal = codec::ordinal(std::invoke(projection, element)).value_or(codec::size);
+      return (ordinal < codec::size) ? codec::template ancestors<Depth>[ordinal] : ordinal;
+    };
+    auto offsets = detail::bucket_sort<codec::size + 1>(input, std::span<element_type>{ outputSpan }, key);
+    if (!offsets.has_value())
+      return result_type{};
+
+    return result_type{ detail::get_groups<codec::size>(std::span<element_type>{ outputSpan }, offsets.value()) };
+  }
+
+  namespace detail
+  {
+    // widest range [min_value, max_value] of a sparse enum that is checked against a bitmap instead of a binary search
+    inline constexpr std::uint64_t maxBitmapRange = std::uint64_t(1) << 16;
+
+    template<typename E>
+    using unsigned_type = std::make_unsigned_t<typename E::underlying_type>;
+
+    template<typename E>
+    inline constexpr std::uint64_t valueRange =
+      unsigned_type<E>(unsigned_type<E>(enum_traits<E>::max_value) - unsigned_type<E>(enum_traits<E>::min_value));
+
+    // bit i is set if min_value + i is the integer of a value of E
+    template<typename E>
+    inline constexpr auto membershipBitmap = []()
+    {
+      constexpr bool fits = valueRange<E> < maxBitmapRange;
+      std::array<std::uint64_t, fits ? valueRange<E> / 64 + 1 : 1> bitmap{};
+      if constexpr (fits)
+        for (auto value : E::enumValues)
+        {
+          auto offset = unsigned_type<E>(unsigned_type<E>(value) - unsigned_type<E>(enum_traits<E>::min_value));
+          bitmap[offset / 64] |= std::uint64_t(1) << (offset % 64);
+        }
+      return bitmap;
+    }();
+
+    // whether integer is the integer of a value of E, free of branches unless E is sparse over a wide range
+    template<typename E>
+    constexpr bool is_value(typename E::underlying_type integer) noexcept
+    {
+      std::uint64_t offset = unsigned_type<E>(unsigned_type<E>(integer) - unsigned_type<E>(enum_traits<E>::min_value));
+      if constexpr (enum_traits<E>::size == 0)
+        return false;
+      else if constexpr (enum_traits<E>::is_contiguous)
+        return offset <= valueRange<E>;
+      else if constexpr (valueRange<E> < maxBitmapRange)
+      {
+        // out of range offsets read the first word so that the load is always in bounds
+        bool inRange = offset <= valueRange<E>;
+        std::uint64_t clamped = inRange ? offset : 0;
+        return inRange & bool((membershipBitmap<E>[clamped / 64] >> (clamped % 64)) & 1);
+      }
+      else
+        return get_position<E>(typename E::Value(integer)) != enum_traits<E>::size;
+    }
+
+    // checks 64 integers at a time into a word of invalid, the inner loop has no early exit so that it can be vectorized
+    template<typename E, bool convert>
+    constexpr std::size_t validate_words(std::span<const typename E::underlying_type> input,
+      std::span<typename E::Value> output, std::span<std::uint64_t> invalid) noexcept
+    {
+      auto check = [&](std::size_t word, std::size_t count)
+      {
+        std::uint64_t bits = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          bool valid = is_value<E>(input[word + i]);
+          if constexpr (convert)
+            output[word + i] = valid ? typename E::Value(input[word + i]) : output[word + i];
+          bits |= std::uint64_t(!valid) << i;
+        }
+        invalid[word / 64] = bits;
+        return (std::size_t)std::popcount(bits);
+      };
+
+      // a constant trip count for the whole words lets the loop be vectorized without a remainder
+      std::size_t failed = 0;
+      std::size_t word = 0;
+      for (; input.size() - word >= 64; word += 64)
+        failed += check(word, 64);
+      if (word < input.size())
+        failed += check(word, input.size() - word);
+      return failed;
+    }
+  }
+
+  // returns the index of the first integer in input that isn't the integer of a value of E, or input.size() if they all are
+  template<NestedEnum E>
+  constexpr std::size_t validate(std::span<const typename E::underlying_type> input) noexcept
+  {
+    // blocks are checked as a whole and only searched for the first invalid integer if they have one
+    for (std::size_t block = 0; block < input.size(); block += 64)
+    {
+      std::size_t end = (input.size() - block < 64) ? input.size() : block + 64;
+      bool valid = true;
+      for (std::size_t i = block; i < end; ++i)
+        valid &= detail::is_value<E>(input[i]);
+
+      if (!valid)
+        for (std::size_t i = block; i < end; ++i)
+          if (!detail::is_value<E>(input[i]))
+            return i;
+    }
+    return input.size();
+  }
+
+  // sets bit i % 64 of invalid[i / 64] if input[i] isn't the integer of a value of E and clears it otherwise
+  // returns how many integers aren't valid, or nothing if invalid is too small
+  template<NestedEnum E>
+  constexpr auto validate(std::span<const typename E::underlying_type> input, std::span<std::uint64_t> invalid) noexcept
+    -> std::optional<std::size_t>
+  {
+    if (invalid.size() < (input.size() + 63) / 64)
+      return {};
+    return detail::validate_words<E, false>(input, {}, invalid);
+  }
+
+  // converts every integer in input that is the integer of a value of E to that value and writes it to the same position
+  // in output, integers that aren't leave their output as is and set their bit in invalid (bit i % 64 of invalid[i / 64])
+  // returns how many integers couldn't be converted, or nothing if output or invalid are too small
+  template<NestedEnum E>
+  constexpr auto convert(std::span<const typename E::underlying_type> input, std::span<typename E::Value> output,
+    std::span<std::uint64_t> invalid) noexcept -> std::optional<std::size_t>
+  {
+    if (output.size() < input.size() || invalid.size() < (input.size() + 63) / 64)
+      return {};
+    return detail::validate_words<E, true>(input, output, invalid);
+  }
+
+  namespace detail
+  {
+    // widest range [min_value, max_value] of an enum that maps its integers to positions with a table
+    inline constexpr std::uint64_t maxPositionTableRange = std::uint64_t(1) << 12;
+
+    // position of min_value + i in the declaration order of E, or the number of values if it isn't one of them
+    // the entry after the range is for all integers outside of it
+    template<typename E>
+    inline constexpr auto positionTable = []()
+    {
+      constexpr bool fits = valueRange<E> < maxPositionTableRange;
+      std::array<std::uint16_t, fits ? valueRange<E> + 2 : 1> table{};
+      table.fill((std::uint16_t)E::enumValues.size());
+      // backwards so that repeated integers map to the first value declared with them, like get_position
+      if constexpr (fits)
+        for (std::size_t i = E::enumValues.size(); i-- > 0;)
+          table[unsigned_type<E>(unsigned_type<E>(E::enumValues[i]) - unsigned_type<E>(enum_traits<E>::min_value))] = (std::uint16_t)i;
+      return table;
+    }();
+
+    // same as get_position, but free of branches unless E is sparse over a wide range
+    template<typename E>
+    constexpr std::size_t branchless_position(typename E::Value value) noexcept
+    {
+      if constexpr (isDense<E> || valueRange<E> >= maxPositionTableRange)
+        return get_position<E>(value);
+      else
+      {
+        std::uint64_t offset = unsigned_type<E>(unsigned_type<E>(value) - unsigned_type<E>(enum_traits<E>::min_value));
+        return positionTable<E>[(offset <= valueRange<E>) ? offset : valueRange<E> + 1];
+      }
+    }
+  }
+
+  // table with a row for every value of Row and a column for every value of Column, in their declaration order
+  // values that aren't part of Row or Column read an extra row or column that is always T{}, so lookups never branch
+  template<NestedEnum Row, NestedEnum Column, typename T>
+  class enum_matrix
+  {
+  public:
+    using value_type = T;
+    static constexpr std::size_t rows = Row::enumValues.size();
+    static constexpr std::size_t columns = Column::enumValues.size();
+
+    struct entry
+    {
+      typename Row::Value row;
+      typename Column::Value column;
+      T value;
+    };
+
+    constexpr enum_matrix() = default;
+    // cells of entries get their value and every other cell is fill, entries that aren't part of Row or Column are skipped
+    constexpr enum_matrix(std::initializer_list<entry> entries, const T &fill = T{})
+    {
+      for (std::size_t row = 0; row < rows; ++row)
+        for (std::size_t column = 0; column < columns; ++column)
+          cells[row * stride + column] = fill;
+      for (const auto &entry : entries)
+        set(entry.row, entry.column, entry.value);
+    }
+
+    constexpr const T &operator()(typename Row::Value row, typename Column::Value column) const noexcept
+    { return cells[detail::branchless_position<Row>(row) * stride + detail::branchless_position<Column>(column)]; }
+    // returns false if row or column isn't part of their enum
+    constexpr bool set(typename Row::Value row, typename Column::Value column, const T &value) noexcept
+    {
+      std::size_t rowPosition = detail::get_position<Row>(row);
+      std::size_t columnPosition = detail::get_position<Column>(column);
+      if (rowPosition == rows || columnPosition == columns)
+        return false;
+
+      cells[rowPosition * stride + columnPosition] = value;
+      return true;
+    }
+
+    constexpr bool operator==(const enum_matrix &) const = default;
+
+  private:
+    static constexpr std::size_t stride = columns + 1;
+
+    std::array<T, (rows + 1) * stride> cells{};
+  };
+
+  // one bit per cell, every row starts at a word of its own
+  template<NestedEnum Row, NestedEnum Column>
+  class enum_matrix<Row, Column, bool>
+  {
+  public:
+    using value_type = bool;
+    static constexpr std::size_t rows = Row::enumValues.size();
+    static constexpr std::size_t columns = Column::enumValues.size();
+
+    constexpr enum_matrix() = default;
+    // cells of pairs are true and every other cell is false, pairs that aren't part of Row or Column are skipped
+    constexpr enum_matrix(std::initializer_list<std::pair<typename Row::Value, typename Column::Value>> pairs)
+    {
+      for (const auto &[row, column] : pairs)
+        set(row, column, true);
+    }
+
+    constexpr bool operator()(typename Row::Value row, typename Column::Value column) const noexcept
+    {
+      std::size_t columnPosition = detail::branchless_position<Column>(column);
+      return (words[detail::branchless_position<Row>(row) * wordsPerRow + columnPosition / 64] >> (columnPosition % 64)) & 1;
+    }
+    // returns false if row or column isn't part of their enum
+    constexpr bool set(typename Row::Value row, typename Column::Value column, bool value) noexcept
+    {
+      std::size_t rowPosition = detail::get_position<Row>(row);
+      std::size_t columnPosition = detail::get_position<Column>(column);
+      if (rowPosition == rows || columnPosition == columns)
+        return false;
+
+      auto &word = words[rowPosition * wordsPerRow + columnPosition / 64];
+      word = (word & ~(std::uint64_t(1) << (columnPosition % 64))) | (std::uint64_t(value) << (columnPosition % 64));
+      return true;
+    }
+
+    constexpr bool operator==(const enum_matrix &) const = default;
+
+  private:
+    // the extra column is always 0
+    static constexpr std::size_t wordsPerRow = (columns + 1 + 63) / 64;
+
+    std::array<std::uint64_t, (rows + 1) * wordsPerRow> words{};
+  };
+
+  namespace detail
+  {
+    // Vose's alias method over N weights, column i is drawn with probabilities[i] and gives way to aliases[i] otherwise
+    template<std::size_t N>
+    struct alias_table
+    {
+      std::array<double, N> probabilities{};
+      std::array<std::uint32_t, N> aliases{};
+
+      // returns false if there aren't N weights, if any of them is negative or not finite, or if they add up to 0
+      constexpr bool build(std::span<const double> weights) noexcept
+      {
+        if (weights.size() != N)
+          return false;
+
+        double total = 0;
+        for (double weight : weights)
+        {
+          // also rejects NaN
+          if (!(weight >= 0 && weight <= std::numeric_limits<double>::max()))
+            return false;
+          total += weight;
+        }
+        if (!(total > 0 && total <= std::numeric_limits<double>::max()))
+          return false;
+
+        // scaled so that the average is 1, every column below it is topped up by one above it
+        std::array<double, N> scaled{};
+        std::array<std::uint32_t, N> small{}, large{};
+        std::size_t smallCount = 0, largeCount = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          scaled[i] = weights[i] / total * (double)N;
+          (scaled[i] < 1 ? small[smallCount++] : large[largeCount++]) = (std::uint32_t)i;
+        }
+        while (smallCount > 0 && largeCount > 0)
+        {
+          std::uint32_t less = small[--smallCount];
+          std::uint32_t more = large[--largeCount];
+          probabilities[less] = scaled[less];
+          aliases[less] = more;
+          scaled[more] = (scaled[more] + scaled[less]) - 1;
+          (scaled[more] < 1 ? small[smallCount++] : large[largeCount++]) = more;
+        }
+        // whatever is left is 1 up to rounding errors
+        for (std::size_t i = 0; i < largeCount; ++i)
+          probabilities[large[i]] = 1, aliases[large[i]] = large[i];
+        for (std::size_t i = 0; i < smallCount; ++i)
+          probabilities[small[i]] = 1, aliases[small[i]] = small[i];
+        return true;
+      }
+
+      // the number of times generator is called depends on its range: once for a full 64 bit engine (mt19937_64),
+      // twice for a full 32 bit one (mt19937) and for any other range as often as it takes to get the 53 bits of a
+      // double, e.g. twice for minstd_rand or ranlux48 and 3 times for ranlux24
+      template<typename URBG>
+      std::size_t draw(URBG &generator) const
+      {
+        constexpr bool full64 = URBG::min() == 0 && std::uint64_t(URBG::max()) == ~std::uint64_t(0);
+        constexpr bool full32 = URBG::min() == 0 && std::uint64_t(URBG::max()) == ~std::uint32_t(0);
+
+        std::size_t column;
+        double coin;
+        if constexpr (full64 || full32)
+        {
+          // 64 random bits, from one call or two 32 bit ones, the high half picks the column (N is far below 2^32,
+          // so the bias is negligible) and the low half is the coin
+          std::uint64_t bits = std::uint64_t(generator());
+          if constexpr (!full64)
+            bits = (bits << 32) | std::uint64_t(generator());
+          column = (std::size_t)(((bits >> 32) * N) >> 32);
+          coin = (double)(bits & 0xFFFFFFFF) * 0x1p-32;
+        }
+        else
+        {
+          // the calls are combined into a number in [0, 1) like std::generate_canonical does (without needing
+          // <random>), times N its integer part is the column and its fraction is the coin
+          constexpr double range = double(URBG::max() - URBG::min()) + 1;
+          constexpr std::size_t calls = []()
+          {
+            std::size_t count = 1;
+            for (double covered = range; covered < 0x1p53; covered *= range)
+              ++count;
+            return count;
+          }();
+
+          double sum = 0, scale = 1;
+          for (std::size_t i = 0; i < calls; ++i, scale *= range)
+            sum += double(generator() - URBG::min()) * scale;
+          double scaled = sum / scale * (double)N;
+          // rounding can make it N
+          column = (scaled < (double)N) ? (std::size_t)scaled : N - 1;
+          coin = scaled - (double)column;
+        }
+        return (coin < probabilities[column]) ? column : aliases[column];
+      }
+    };
+  }
+
+  // draws values of E in constant time with the alias method, each with a probability proportional to its weight
+  template<NestedEnum E>
+  class alias_sampler
+  {
+  public:
+    using value_type = E;
+    static constexpr std::size_t size = E::enumValues.size();
+
+    // weights of the values of E in declaration order
+    // returns nothing if there aren't as many weights as values, if any of them is negative or not finite, or if they add up to 0
+    static constexpr auto make(std::span<const double> weights) noexcept -> std::optional<alias_sampler>
+    {
+      alias_sampler sampler;
+      if (!sampler.table.build(weights))
+        return {};
+      return sampler;
+    }
+    // weight(value) is the weight of every value of E
+    template<typename Weight> requires std::is_invocable_r_v<double, Weight &, E>
+    static constexpr auto make(Weight &&weight) -> std::optional<alias_sampler>
+    {
+      std::array<double, size> weights{};
+      for (std::size_t i = 0; i < size; ++i)
+        weights[i] = std::invoke(weight, E{ E::enumValues[i] });
+      return make(weights);
+    }
+
+    template<typename URBG>
+    E operator()(URBG &generator) const { return E{ E::enumValues[table.draw(generator)] }; }
+
+  private:
+    constexpr alias_sampler() = default;
+
+    detail::alias_table<size> table{};
+  };
+
+  // draws the values without children anywhere in the tree of E in constant time with the alias method,
+  // in the same order as tree_view<E, Outer> and each with a probability proportional to its weight
+  template<NestedEnum E>
+  class alias_sampler_recursive
+  {
+    using codec = tree_codec<E>;
+
+    static constexpr auto &ordinals = detail::selectedOrdinals<E, Outer>;
+
+  public:
+    using value_type = typename codec::value_type;
+    static constexpr std::size_t size = ordinals.size();
+
+    // weights of the values without children in the order of tree_view<E, Outer>
+    // returns nothing if there aren't as many weights as values, if any of them is negative or not finite, or if they add up to 0
+    static constexpr auto make(std::span<const double> weights) noexcept -> std::optional<alias_sampler_recursive>
+    {
+      alias_sampler_recursive sampler;
+      if (!sampler.table.build(weights))
+        return {};
+      return sampler;
+    }
+    // weight(value) is the weight of every value without children, value is a tree_codec<E>::value_type
+    template<typename Weight> requires std::is_invocable_r_v<double, Weight &, const value_type &>
+    static constexpr auto make(Weight &&weight) -> std::optional<alias_sampler_recursive>
+    {
+      std::array<double, size> weights{};
+      for (std::size_t i = 0; i < size; ++i)
+        weights[i] = std::invoke(weight, codec::value(ordinals[i]));
+      return make(weights);
+    }
+
+    template<typename URBG>
+    value_type operator()(URBG &generator) const { return codec::value(ordinals[table.draw(generator)]); }
+    // ordinal (see tree_codec) of a drawn value, which saves constructing the value itself
+    template<typename URBG>
+    std::size_t ordinal(URBG &generator) const { return ordinals[table.draw(generator)]; }
+
+  private:
+    constexpr alias_sampler_recursive() = default;
+
+    detail::alias_table<size> table{};
+  };
+
+  namespace detail
+  {
+    // values without a linked type hold an empty std::monostate
+    template<typename T>
+    using linked_storage_t = std::conditional_t<std::is_void_v<typename T::linked_type>, std::monostate, typename T::linked_type>;
+
+    template<typename ... Ts>
+    auto get_linked_tuple(type_list<Ts...>) -> std::tuple<linked_storage_t<Ts>...>;
+  }
+
+  // one instance of the linked_type of every value of E in declaration order, stored together in a std::tuple
+  // every value needs to be defined by the time the tuple is used (deferred ones included)
+  template<NestedEnum E>
+  class linked_tuple
+  {
+  public:
+    using tuple_type = decltype(detail::get_linked_tuple(E::subtypes));
+    static constexpr std::size_t size = E::enumValues.size();
+
+    constexpr linked_tuple() = default;
+    // constructs every instance from its own argument, in declaration order
+    template<typename ... Args> requires (sizeof...(Args) == size && size > 0)
+    constexpr explicit linked_tuple(Args &&... args) : elements(std::forward<Args>(args)...) {}
+
+    template<typename E::Value value>
+    constexpr auto &get() noexcept { return std::get<position<value>()>(elements); }
+    template<typename E::Value value>
+    constexpr const auto &get() const noexcept { return std::get<position<value>()>(elements); }
+
+    constexpr tuple_type &tuple() noexcept { return elements; }
+    constexpr const tuple_type &tuple() const noexcept { return elements; }
+
+    // calls function with the instance of value through a table of functions, one for every value
+    // function has to return the same type for every instance, which is returned as an std::optional
+    // (or as a bool if it's void) that is empty if value isn't part of E
+    template<typename Function> requires (size > 0)
+    constexpr auto visit(typename E::Value value, Function &&function) { return visit_internal(elements, value, function); }
+    template<typename Function> requires (size > 0)
+    constexpr auto visit(typename E::Value value, Function &&function) const { return visit_internal(elements, value, function); }
+
+  private:
+    template<typename E::Value value>
+    static constexpr std::size_t position() noexcept
+    {
+      constexpr std::size_t result = detail::get_position<E>(value);
+      static_assert(result < size, "value isn't part of this enum");
+      return result;
+    }
+
+    template<std::size_t I, typename Elements, typename Function>
+    static constexpr decltype(auto) call(Elements &elements, Function &function)
     {
-      auto typeId = find_type_recursive_internal<[]<typename T>()
+      return std::invoke(function, std::get<I>(elements));
+    }
+
+    template<typename Elements, typename Function>
+    static constexpr auto visit_internal(Elements &elements, typename E::Value value, Function &function)
+    {
+      using result_type = decltype(call<0>(elements, function));
+      constexpr auto table = []<std::size_t ... Is>(std::index_sequence<Is...>)
       {
-        return std::is_same_v<decltype(value), typename T::Value>;
-      }>(E::subtypes);
+        static_assert((std::is_same_v<result_type, decltype(call<Is>(elements, function))> && ...),
+          "function has to return the same type for every linked type");
+        return std::array<result_type (*)(Elements &, Function &), size>{ &call<Is, Elements, Function>... };
+      }(std::make_index_sequence<size>{});
 
-      if constexpr (typeId.size == 0)
-        return {};
+      std::size_t position = detail::branchless_position<E>(value);
+      if constexpr (std::is_void_v<result_type>)
+      {
+        if (position == size)
+          return false;
+        table[position](elements, function);
+        return true;
+      }
       else
       {
-        using subType = decltype(detail::get_first_type(typeId));
-        return subType::enum_name(value, clean);
+        using optional_type = std::optional<std::remove_cvref_t<result_type>>;
+        if (position == size)
+          return optional_type{};
+        return optional_type{ table[position](elements, function) };
       }
     }
-    // returns the reflected string of an enum with the specified id that is located somewhere in the subtree
-    // the algorithm is a top-down DFS (in case you have repeating ids, which is not a good idea)
-    static constexpr auto enum_name_by_id_recursive(std::string_view id, bool clean = false) -> std::optional<std::string_view>
-    {
-      auto value = enum_name_by_id(id, clean);
-      if (value.has_value())
-        return value;
 
-      if constexpr (E::enumValues.size() == 0)
-        return {};
-      else
-      {
-        return []<typename ... Ts>(std::string_view id, bool clean, detail::type_list<Ts...>)
-        {
-          constexpr auto recurse = []<auto Self, typename U, typename ... Us>(std::string_view id, bool clean)
-          {
-            auto value = U::enum_name_by_id_recursive(id, clean);
-            if (value.has_value())
-              return value;
+    tuple_type elements{};
+  };
 
-            if constexpr (sizeof...(Us) > 0)
-              return Self.template operator()<Self, Us...>(id, clean);
-            else
-              return std::optional<std::string_view>{};
-          };
+  namespace detail
+  {
+    template<typename E>
+    inline constexpr bool isFlags = requires { requires E::isFlags; };
 
-          return recurse.template operator()<recurse, Ts...>(id, clean);
-        }(id, clean, E::subtypes);
-      }
-    }
-    // returns the id of an enum value that is located somewhere in the subtree
-    static constexpr auto enum_id_recursive(detail::Enum auto value) -> std::optional<std::string_view>
+    // value of the flag at index, used by the enums defined with NESTED_ENUM_FLAGS
+    template<typename T, typename Index>
+    constexpr T flag_value(Index index) noexcept
     {
-      auto typeId = find_type_recursive_internal<[]<typename T>()
-      {
-        return std::is_same_v<decltype(value), typename T::Value>;
-      }>(E::subtypes);
-
-      if constexpr (typeId.size == 0)
-        return {};
-      else
-      {
-        using subType = decltype(detail::get_first_type(typeId));
-        return subType::enum_id(value);
-      }
+      return T(std::make_unsigned_t<T>(1) << std::size_t(index));
     }
-    // returns the id of an enum with the specified reflected string that is located somewhere in the subtree
-    static constexpr auto enum_id_recursive(std::string_view enumName) -> std::optional<std::string_view>
+
+    // names of the single bit values of E by their bit index, composite values are only used for parsing
+    template<typename E, bool clean>
+    constexpr auto get_flag_names() noexcept
     {
-      auto value = enum_id(enumName);
-      if (value.has_value())
-        return value;
+      using bits_type = std::make_unsigned_t<typename E::underlying_type>;
+      // default initialised on purpose, GCC 12 rejects reading the value initialised array in constant expressions
+      std::array<std::string_view, std::bit_width(bits_type(~bits_type(0)))> names;
+      auto enumNames = E::template enum_names<All>(clean);
+      for (std::size_t i = 0; i < enumNames.size(); ++i)
+        if (std::has_single_bit(bits_type(E::enumValues[i])))
+          names[std::countr_zero(bits_type(E::enumValues[i]))] = enumNames[i];
+      return names;
+    }
 
-      if constexpr (E::enumValues.size() == 0)
-        return {};
-      else
-      {
-        return []<typename ... Ts>(std::string_view enumName, detail::type_list<Ts...>)
-        {
-          constexpr auto recurse = []<auto Self, typename U, typename ... Us>(std::string_view enumName)
-          {
-            auto value = U::enum_id_recursive(enumName);
-            if (value.has_value())
-              return value;
+    template<typename E, bool clean>
+    inline constexpr auto flagNames = get_flag_names<E, clean>();
+  }
 
-            if constexpr (sizeof...(Us) > 0)
-              return Self.template operator()<Self, Us...>(enumName);
-            else
-              return std::optional<std::string_view>{};
-          };
+  // set of values of an enum defined with NESTED_ENUM_FLAGS, where every value is a bit or a combination of bits
+  // returned by the |, &, ^ and ~ operators of the enum values
+  template<NestedEnum E> requires detail::isFlags<E>
+  class flag_mask
+  {
+  public:
+    using enum_type = E;
+    using bits_type = std::make_unsigned_t<typename E::underlying_type>;
 
-          return recurse.template operator()<recurse, Ts...>(enumName);
-        }(enumName, E::subtypes);
-      }
-    }
-    // returns the underlying integer of an enum value that is located somewhere in the subtree, specified by its reflected string
-    // make sure to provide the full enum name to avoid erroneous results
-    template<fixed_string enumName>
-    static constexpr auto enum_integer_recursive()
+    // all the bits used by the values of E
+    static constexpr bits_type all = []()
     {
-      auto typeId = find_type_recursive_internal<[]<typename T>()
-      {
-        constexpr auto enumInteger = T::enum_integer(std::string_view(enumName));
-        return enumInteger.has_value();
-      }>(E::subtypes);
+      bits_type bits = 0;
+      for (auto value : E::enumValues)
+        bits |= bits_type(value);
+      return bits;
+    }();
 
-      if constexpr (typeId.size == 0)
-        return std::optional<typename E::underlying_type>{};
-      else
-      {
-        using subType = decltype(detail::get_first_type(typeId));
-        return subType::enum_integer(std::string_view(enumName));
-      }
-    }
-    // returns the underlying integer of an enum value that is located somewhere in the subtree, specified by its id
-    template<fixed_string id>
-    static constexpr auto enum_integer_by_id_recursive()
+    constexpr flag_mask() noexcept = default;
+    constexpr flag_mask(typename E::Value value) noexcept : internalBits(bits_type(value)) { }
+    constexpr flag_mask(E value) noexcept : internalBits(bits_type(typename E::Value(value))) { }
+
+    // returns a mask of the given bits, or nothing if some of them aren't used by any value
+    static constexpr auto from_bits(bits_type bits) noexcept -> std::optional<flag_mask>
     {
-      auto typeId = find_type_recursive_internal<[]<typename T>()
-      {
-        constexpr auto value = T::enum_integer_by_id(std::string_view(id));
-        return value.has_value();
-      }>(E::subtypes);
+      if ((bits & ~all) != 0)
+        return {};
 
-      if constexpr (typeId.size == 0)
-        return std::optional<typename E::underlying_type>{};
-      else
-      {
-        using subType = decltype(detail::get_first_type(typeId));
-        return subType::enum_integer_by_id(std::string_view(id));
-      }
+      flag_mask mask;
+      mask.internalBits = bits;
+      return mask;
     }
-    // returns an enum value that is located somewhere in the subtree, specified by its reflected string
-    template<fixed_string enumName>
-    static constexpr auto enum_value_recursive()
+
+    constexpr bits_type bits() const noexcept { return internalBits; }
+    constexpr bool empty() const noexcept { return internalBits == 0; }
+    constexpr explicit operator bool() const noexcept { return internalBits != 0; }
+    // whether all the bits of other are set
+    constexpr bool contains(flag_mask other) const noexcept { return (internalBits & other.internalBits) == other.internalBits; }
+
+    constexpr flag_mask &operator|=(flag_mask other) noexcept { internalBits |= other.internalBits; return *this; }
+    constexpr flag_mask &operator&=(flag_mask other) noexcept { internalBits &= other.internalBits; return *this; }
+    constexpr flag_mask &operator^=(flag_mask other) noexcept { internalBits ^= other.internalBits; return *this; }
+
+    friend constexpr flag_mask operator|(flag_mask left, flag_mask right) noexcept { return left |= right; }
+    friend constexpr flag_mask operator&(flag_mask left, flag_mask right) noexcept { return left &= right; }
+    friend constexpr flag_mask operator^(flag_mask left, flag_mask right) noexcept { return left ^= right; }
+    // only flips the bits used by the values of E
+    friend constexpr flag_mask operator~(flag_mask mask) noexcept { mask.internalBits = ~mask.internalBits & all; return mask; }
+    friend constexpr bool operator==(flag_mask, flag_mask) noexcept = default;
+
+    // parses names separated by separator (e.g. "Read|Write|Exec"), whitespace around the names is ignored
+    // names are the clean ones unless clean is false, an empty string is an empty mask
+    // every name is looked up in a hash table, so this is linear in the length of the string
+    // returns nothing if any of the names isn't part of E
+    template<bool clean = true> requires detail::hasNames<E>
+    static constexpr auto parse(std::string_view string, char separator = '|') noexcept -> std::optional<flag_mask>
     {
-      auto typeId = find_type_recursive_internal<[]<typename T>()
-      {
-        constexpr auto value = T::enum_value(std::string_view(enumName));
-        return value.has_value();
-      }>(E::subtypes);
+      constexpr std::string_view whitespace = " \t\n\r\f\v";
+      flag_mask mask;
+      if (string.find_first_not_of(whitespace) == std::string_view::npos)
+        return mask;
 
-      if constexpr (typeId.size == 0)
-        return std::optional<E>{};
-      else
+      while (true)
       {
-        using subType = decltype(detail::get_first_type(typeId));
-        return subType::enum_value(std::string_view(enumName));
+        std::size_t end = string.find(separator);
+        std::string_view name = string.substr(0, end);
+        std::size_t first = name.find_first_not_of(whitespace);
+        if (first == std::string_view::npos)
+          return {};
+        name = name.substr(first, name.find_last_not_of(whitespace) - first + 1);
+
+        std::size_t position = E::enumValues.size();
+        detail::nameIndex<E, clean>.find(name, [&](std::size_t match) { position = match; });
+        if (position == E::enumValues.size())
+          return {};
+
+        mask |= E::enumValues[position];
+        if (end == std::string_view::npos)
+          return mask;
+        string.remove_prefix(end + 1);
       }
     }
-    // returns an enum value that is located somewhere in the subtree, specified by its id
-    template<fixed_string id>
-    static constexpr auto enum_value_by_id_recursive()
+
+    // size of the longest string format can write
+    template<bool clean = true> requires detail::hasNames<E>
+    static constexpr std::size_t max_formatted_size() noexcept
     {
-      auto typeId = find_type_recursive_internal<[]<typename T>()
-      {
-        constexpr auto value = T::enum_value_by_id(std::string_view(id));
-        return value.has_value();
-      }>(E::subtypes);
+      std::size_t size = 0;
+      for (auto name : detail::flagNames<E, clean>)
+        if (!name.empty())
+          size += name.size() + 1;
+      return (size != 0) ? size - 1 : 0;
+    }
 
-      if constexpr (typeId.size == 0)
-        return std::optional<E>{};
-      else
+    // writes the names of the set bits into buffer in order of the bits, separated by separator
+    // names are the clean ones unless clean is false, an empty mask is an empty string
+    // returns the written string, or nothing if the buffer is too small or a bit is set that no single value has
+    template<bool clean = true> requires detail::hasNames<E>
+    constexpr auto format(std::span<char> buffer, char separator = '|') const noexcept -> std::optional<std::string_view>
+    {
+      std::size_t size = 0;
+      for (bits_type bits = internalBits; bits != 0; bits &= bits - 1)
       {
-        using subType = decltype(detail::get_first_type(typeId));
-        return subType::enum_value_by_id(std::string_view(id));
+        std::string_view name = detail::flagNames<E, clean>[std::countr_zero(bits)];
+        if (name.empty() || size + name.size() + (size != 0) > buffer.size())
+          return {};
+
+        if (size != 0)
+          buffer[size++] = separator;
+        for (char character : name)
+          buffer[size++] = character;
       }
+      return std::string_view{ buffer.data(), size };
     }
-  };
 
-  template<class E>
-  concept NestedEnum = requires { typename E::nested_enum_tag; };
+  private:
+    bits_type internalBits = 0;
+  };
 
-  // helper function for doing recursive iteration over types with enum_subtypes()
-  // it is intended for expanding branches without needing to write them manually
-  // 1st template parameter is the lambda itself and consequent template parameters are the deduced types
-  // Example:
-  // 
-  // template<nested_enum::NestedEnum T>
-  // void do_thing(T value)
-  // {
-  //   nested_enum::recurse_over_types<[]<auto Self, typename U, typename ... Us>(T value)
-  //     {
-  //       if constexpr (std::is_same_v<decltype(U::value()), T>)
-  //         if (U::value() == value)
-  //           do_something_else<typename U::linked_type>();
-  //       
-  //       if constexpr (sizeof...(Us) > 0)
-  //         Self.template operator()<Self, Us...>(value);
-  //       else
-  //       {
-  //         // Uncaught case
-  //         assert(false);
-  //       }
-  //     }>(SomeEnum::enum_subtypes(), value);
-  // }
-  //
-  // keep in mind that as of C++20 only captureless lambdas can be used as non-type template parameters
-  // any extra parameters can be passed in as a parameter pack
-  template<auto Lambda, typename ... Ts, typename ... Args>
-  constexpr auto recurse_over_types(const std::tuple<std::type_identity<Ts>...> &, Args&& ... args)
+  namespace detail
   {
-    return Lambda.template operator()<Lambda, Ts...>(std::forward<Args>(args)...);
+    // std::variant over nodes of a tree, like tree_codec<E>::value_type
+    template<typename T>
+    inline constexpr bool is_tree_value_v = false;
+    template<NestedEnum ... Ts>
+    inline constexpr bool is_tree_value_v<std::variant<std::monostate, Ts...>> = sizeof...(Ts) > 0;
   }
 
-  template <typename E, typename P>
-  constexpr bool operator==(const nested_enum<E, P> &left, const nested_enum<E, P> &right) noexcept
+  // writes the full name of the value, or its integer if names were left out
+  template<typename Traits, NestedEnum E>
+  auto operator<<(std::basic_ostream<char, Traits> &stream, const E &value) -> std::basic_ostream<char, Traits> &
   {
-    return static_cast<const E &>(left).internalValue == static_cast<const E &>(right).internalValue;
+    if constexpr (detail::hasNames<E>)
+      return stream << value.enum_name();
+    else
+      return stream << +value.enum_integer();
   }
 
-  template <typename E, typename P>
-  constexpr bool operator==(const nested_enum<E, P> &left, const typename E::Value &right) noexcept
+  // writes the names of the set bits separated by '|', or the bits as an integer if names were left out
+  // bits that no single value has are written as an integer after the names
+  template<typename Traits, typename E>
+  auto operator<<(std::basic_ostream<char, Traits> &stream, const flag_mask<E> &mask) -> std::basic_ostream<char, Traits> &
   {
-    return static_cast<const E &>(left).internalValue == right;
+    using bits_type = typename flag_mask<E>::bits_type;
+    if constexpr (!detail::hasNames<E>)
+      return stream << +mask.bits();
+    else
+    {
+      bits_type unnamed = 0;
+      bool first = true;
+      for (bits_type bits = mask.bits(); bits != 0; bits &= bits - 1)
+      {
+        std::string_view name = detail::flagNames<E, true>[std::countr_zero(bits)];
+        if (name.empty())
+        {
+          unnamed |= bits & ~(bits - 1);
+          continue;
+        }
+
+        stream << (first ? "" : "|") << name;
+        first = false;
+      }
+      if (unnamed != 0)
+        stream << (first ? "" : "|") << +unnamed;
+      return stream;
+    }
   }
 
-  template <typename E, typename P>
-  constexpr bool operator==(const typename E::Value &left, const nested_enum<E, P> &right) noexcept
+  // writes the held value, std::monostate writes nothing
+  template<typename Traits, typename T> requires detail::is_tree_value_v<T>
+  auto operator<<(std::basic_ostream<char, Traits> &stream, const T &value) -> std::basic_ostream<char, Traits> &
   {
-    return left == static_cast<const E &>(right).internalValue;
+    std::visit([&]<typename U>(const U &alternative)
+      {
+        if constexpr (!std::is_same_v<U, std::monostate>)
+          stream << alternative;
+      }, value);
+    return stream;
   }
 }
 
 #undef TEST_INCLUSIVENESS
+
+#endif
+
+// rescans the output of a NESTED_ENUM, every rescan defines one more level of the tree (see NESTED_ENUM_INTERNAL_TREE_)
+// walking over the entries of an enum doesn't need any rescans so this only limits the depth, which is 20 levels below the root
+// (nodes up to a depth of 21, see NESTED_ENUM_INTERNAL_CHILD_OF_21)
 #define NESTED_ENUM_INTERNAL_EXPAND(...) NESTED_ENUM_INTERNAL_EXPAND4(NESTED_ENUM_INTERNAL_EXPAND4(NESTED_ENUM_INTERNAL_EXPAND4(NESTED_ENUM_INTERNAL_EXPAND4(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND4(...) NESTED_ENUM_INTERNAL_EXPAND3(NESTED_ENUM_INTERNAL_EXPAND3(NESTED_ENUM_INTERNAL_EXPAND3(NESTED_ENUM_INTERNAL_EXPAND3(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND3(...) NESTED_ENUM_INTERNAL_EXPAND2(NESTED_ENUM_INTERNAL_EXPAND2(NESTED_ENUM_INTERNAL_EXPAND2(NESTED_ENUM_INTERNAL_EXPAND2(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND2(...) NESTED_ENUM_INTERNAL_EXPAND1(NESTED_ENUM_INTERNAL_EXPAND1(NESTED_ENUM_INTERNAL_EXPAND1(NESTED_ENUM_INTERNAL_EXPAND1(__VA_ARGS__))))
+#define NESTED_ENUM_INTERNAL_EXPAND4(...) NESTED_ENUM_INTERNAL_EXPAND1(NESTED_ENUM_INTERNAL_EXPAND1(NESTED_ENUM_INTERNAL_EXPAND1(NESTED_ENUM_INTERNAL_EXPAND1(__VA_ARGS__))))
 #define NESTED_ENUM_INTERNAL_EXPAND1(...) __VA_ARGS__
 
-// first one gets used to define horizonal things while this is used for the depth
-#define NESTED_ENUM_INTERNAL_EXPAND_SECOND(...) NESTED_ENUM_INTERNAL_EXPAND_SECOND4(NESTED_ENUM_INTERNAL_EXPAND_SECOND4(NESTED_ENUM_INTERNAL_EXPAND_SECOND4(NESTED_ENUM_INTERNAL_EXPAND_SECOND4(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND_SECOND4(...) NESTED_ENUM_INTERNAL_EXPAND_SECOND3(NESTED_ENUM_INTERNAL_EXPAND_SECOND3(NESTED_ENUM_INTERNAL_EXPAND_SECOND3(NESTED_ENUM_INTERNAL_EXPAND_SECOND3(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND_SECOND3(...) NESTED_ENUM_INTERNAL_EXPAND_SECOND2(NESTED_ENUM_INTERNAL_EXPAND_SECOND2(NESTED_ENUM_INTERNAL_EXPAND_SECOND2(NESTED_ENUM_INTERNAL_EXPAND_SECOND2(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND_SECOND2(...) NESTED_ENUM_INTERNAL_EXPAND_SECOND1(NESTED_ENUM_INTERNAL_EXPAND_SECOND1(NESTED_ENUM_INTERNAL_EXPAND_SECOND1(NESTED_ENUM_INTERNAL_EXPAND_SECOND1(__VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_EXPAND_SECOND1(...) __VA_ARGS__
-
 #define NESTED_ENUM_INTERNAL_PARENS ()
-#define NESTED_ENUM_INTERNAL_EMPTY()
-
-#define NESTED_ENUM_INTERNAL_EMPTY_STACK() NESTED_ENUM_INTERNAL_EMPTY4(NESTED_ENUM_INTERNAL_EMPTY4(NESTED_ENUM_INTERNAL_EMPTY4(NESTED_ENUM_INTERNAL_EMPTY4(NESTED_ENUM_INTERNAL_EMPTY))))
-#define NESTED_ENUM_INTERNAL_EMPTY4(...) NESTED_ENUM_INTERNAL_EMPTY3(NESTED_ENUM_INTERNAL_EMPTY3(NESTED_ENUM_INTERNAL_EMPTY3(NESTED_ENUM_INTERNAL_EMPTY3(__VA_ARGS__ NESTED_ENUM_INTERNAL_EMPTY))))
-#define NESTED_ENUM_INTERNAL_EMPTY3(...) NESTED_ENUM_INTERNAL_EMPTY2(NESTED_ENUM_INTERNAL_EMPTY2(NESTED_ENUM_INTERNAL_EMPTY2(NESTED_ENUM_INTERNAL_EMPTY2(__VA_ARGS__ NESTED_ENUM_INTERNAL_EMPTY))))
-#define NESTED_ENUM_INTERNAL_EMPTY2(...) NESTED_ENUM_INTERNAL_EMPTY1(NESTED_ENUM_INTERNAL_EMPTY1(NESTED_ENUM_INTERNAL_EMPTY1(NESTED_ENUM_INTERNAL_EMPTY1(__VA_ARGS__ NESTED_ENUM_INTERNAL_EMPTY))))
-#define NESTED_ENUM_INTERNAL_EMPTY1(...) __VA_ARGS__ NESTED_ENUM_INTERNAL_EMPTY
-
-#define NESTED_ENUM_INTERNAL_PAREN_STACK() NESTED_ENUM_INTERNAL_PAREN4(NESTED_ENUM_INTERNAL_PAREN4(NESTED_ENUM_INTERNAL_PAREN4(NESTED_ENUM_INTERNAL_PAREN4(()))))
-#define NESTED_ENUM_INTERNAL_PAREN4(...) NESTED_ENUM_INTERNAL_PAREN3(NESTED_ENUM_INTERNAL_PAREN3(NESTED_ENUM_INTERNAL_PAREN3(NESTED_ENUM_INTERNAL_PAREN3(() __VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_PAREN3(...) NESTED_ENUM_INTERNAL_PAREN2(NESTED_ENUM_INTERNAL_PAREN2(NESTED_ENUM_INTERNAL_PAREN2(NESTED_ENUM_INTERNAL_PAREN2(() __VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_PAREN2(...) NESTED_ENUM_INTERNAL_PAREN1(NESTED_ENUM_INTERNAL_PAREN1(NESTED_ENUM_INTERNAL_PAREN1(NESTED_ENUM_INTERNAL_PAREN1(() __VA_ARGS__))))
-#define NESTED_ENUM_INTERNAL_PAREN1(...) () __VA_ARGS__
-
-#define NESTED_ENUM_INTERNAL_DEFER(...)  __VA_ARGS__ NESTED_ENUM_INTERNAL_EMPTY_STACK() NESTED_ENUM_INTERNAL_PAREN_STACK()
-#define NESTED_ENUM_INTERNAL_DEFER_ADD(id) NESTED_ENUM_INTERNAL_EMPTY NESTED_ENUM_INTERNAL_EMPTY id () ()
 
 
 // this person is a genius https://stackoverflow.com/a/62984543
@@ -1212,33 +3676,200 @@ namespace nested_enum
 #define NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY(a1, ...) a1
 #define NESTED_ENUM_INTERNAL_GET_SECOND_OF_MANY(a1, a2, ...) a2
 #define NESTED_ENUM_INTERNAL_GET_THIRD_OF_MANY(a1, a2, a3, ...) a3
+#define NESTED_ENUM_INTERNAL_GET_FOURTH_OF_MANY(a1, a2, a3, a4, ...) a4
 #define NESTED_ENUM_INTERNAL_SKIP_FIRST_OF_MANY(a1, ...) __VA_ARGS__
 #define NESTED_ENUM_INTERNAL_GET_THIRD_IF_EXISTS(a1, ...) __VA_OPT__(NESTED_ENUM_INTERNAL_SKIP_FIRST_OF_MANY(__VA_ARGS__))
 
 
-#define NESTED_ENUM_INTERNAL_FOR_EACH(helper, macro, ...) __VA_OPT__(NESTED_ENUM_INTERNAL_EXPAND(helper(macro, __VA_ARGS__)))
-
-#define NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE(macro, separator, a1, ...)                                                                       \
-    macro (NESTED_ENUM_INTERNAL_DEPAREN(a1)) __VA_OPT__(NESTED_ENUM_INTERNAL_DEPAREN(separator))                                                                 \
-    __VA_OPT__(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_AGAIN NESTED_ENUM_INTERNAL_PARENS (macro, separator, __VA_ARGS__))
-#define NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_AGAIN() NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE
-
-#define NESTED_ENUM_INTERNAL_INTERLEAVE_TWO(sequence1, item2, ...)                                                                      \
-    (NESTED_ENUM_INTERNAL_GET_TYPE(NESTED_ENUM_INTERNAL_DEPAREN(item2)), NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY sequence1)            \
-    __VA_OPT__(, NESTED_ENUM_INTERNAL_INTERLEAVE_TWO_AGAIN NESTED_ENUM_INTERNAL_PARENS ((NESTED_ENUM_INTERNAL_SKIP_FIRST_OF_MANY sequence1), __VA_ARGS__))
-#define NESTED_ENUM_INTERNAL_INTERLEAVE_TWO_AGAIN() NESTED_ENUM_INTERNAL_INTERLEAVE_TWO
-
-
-#define NESTED_ENUM_INTERNAL_GET_TYPE(...) NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY(__VA_ARGS__)
-#define NESTED_ENUM_INTERNAL_GET_TYPE_STRING(...) NESTED_ENUM_INTERNAL_STRINGIFY(NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY(__VA_ARGS__))
-
-#define NESTED_ENUM_INTERNAL_PASTE_VAL(value) value, , 
-#define NESTED_ENUM_INTERNAL_PASTE_ID(id) , id, 
-#define NESTED_ENUM_INTERNAL_PASTE_TYPE(type) , ,type
-#define NESTED_ENUM_INTERNAL_PASTE_VAL_ID(value, id) value, id,
-#define NESTED_ENUM_INTERNAL_PASTE_VAL_TYPE(value, type) value, , type
-#define NESTED_ENUM_INTERNAL_PASTE_ID_TYPE(id, type) , id, type
-#define NESTED_ENUM_INTERNAL_PASTE_VAL_ID_TYPE(value, id, type) value, id, type
+// this is where the magic happens, so i'll write down how it works before i forget
+// for_each calls macro(extraArgs, specialisation, entry...) for every entry, where specialisation is the matching element of the
+// specialisations sequence (or nothing if the sequence is shorter than the entries)
+// instead of recursing through deferred expressions, which needs a fixed stack of EXPANDs rescanning everything over and over,
+// the entries are consumed in chunks of 16 and every chunk is handled by its own STEP macro that directly invokes the next one
+// because every STEP has a different name none of them get painted blue, so the work done is proportional to the entries count
+// and the only limit is the number of STEP macros (16 * 128 = 2048 entries per enum)
+#define NESTED_ENUM_INTERNAL_FOR_EACH(macro, extraArgs, specialisations, ...) __VA_OPT__(NESTED_ENUM_INTERNAL_FOR_EACH_STEP1(macro, extraArgs, specialisations, __VA_ARGS__))
+
+// pads the entries and specialisations to 16 elements, empty elements are skipped
+#define NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, specialisations, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK1(macro, extraArgs, specialisations, __VA_ARGS__, , , , , , , , , , , , , , , , )
+#define NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK1(macro, extraArgs, specialisations, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) \
+    NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK2(macro, extraArgs, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, NESTED_ENUM_INTERNAL_DEPAREN(specialisations), , , , , , , , , , , , , , , , )
+#define NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK2(...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK3(__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK3(macro, extraArgs, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15, s16, ...) \
+    NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s1, a1) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s2, a2) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s3, a3) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s4, a4) \
+    NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s5, a5) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s6, a6) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s7, a7) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s8, a8) \
+    NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s9, a9) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s10, a10) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s11, a11) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s12, a12) \
+    NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s13, a13) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s14, a14) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s15, a15) NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, s16, a16)
+#define NESTED_ENUM_INTERNAL_FOR_EACH_ITEM(macro, extraArgs, specialisation, ...) __VA_OPT__(NESTED_ENUM_INTERNAL_FOR_EACH_CALL(macro, extraArgs, specialisation, NESTED_ENUM_INTERNAL_DEPAREN(__VA_ARGS__)))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_CALL(macro, ...) macro(__VA_ARGS__)
+
+// chooses the next STEP if there are more than 16 entries left, the arguments are only expanded when the STEP is chosen
+// so skipping the first 16 entries is safe, while the specialisations are padded because they can be fewer than the entries
+#define NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(next, specialisations, ...) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT1(next, NESTED_ENUM_INTERNAL_FOR_EACH_GET_17TH(__VA_ARGS__, , , , , , , , , , , , , , , , ))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_NEXT1(next, ...) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT_ ## __VA_OPT__(CONTINUE)(next)
+#define NESTED_ENUM_INTERNAL_FOR_EACH_NEXT_(next) NESTED_ENUM_INTERNAL_FOR_EACH_STOP
+#define NESTED_ENUM_INTERNAL_FOR_EACH_NEXT_CONTINUE(next) next
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STOP(...)
+#define NESTED_ENUM_INTERNAL_FOR_EACH_GET_17TH(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, ...) a17
+#define NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(specialisations, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) \
+    (NESTED_ENUM_INTERNAL_FOR_EACH_SKIP_SPECIALISATIONS(NESTED_ENUM_INTERNAL_DEPAREN(specialisations), , , , , , , , , , , , , , , , )), __VA_ARGS__
+#define NESTED_ENUM_INTERNAL_FOR_EACH_SKIP_SPECIALISATIONS(...) NESTED_ENUM_INTERNAL_FOR_EACH_SKIP_SPECIALISATIONS1(__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_FOR_EACH_SKIP_SPECIALISATIONS1(s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15, s16, ...) __VA_ARGS__
+// past the limit the remaining entries are dropped, except that the walks over the enumerators add one more that fails
+// the static_assert in detail::entry_limit, since the enumerators come first that is the first error of the definition
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_REACHED(macro, ...) NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_REACHED1(NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_ ## macro, )
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_REACHED1(...) NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_REACHED2(__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_REACHED2(probe, enumerator, ...) enumerator
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_ENUMERATOR internalEntryLimitReached = ::nested_enum::detail::entry_limit<false>::value,
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_NESTED_ENUM_INTERNAL_DEFINE_ENUM ~, NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_ENUMERATOR
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_NESTED_ENUM_INTERNAL_DEFINE_FLAG ~, NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_ENUMERATOR
+#define NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX ~, NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_ENUMERATOR
+
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP1(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP2, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP2(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP3, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP3(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP4, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP4(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP5, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP5(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP6, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP6(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP7, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP7(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP8, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP8(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP9, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP9(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP10, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP10(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP11, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP11(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP12, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP12(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP13, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP13(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP14, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP14(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP15, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP15(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP16, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP16(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP17, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP17(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP18, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP18(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP19, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP19(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP20, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP20(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP21, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP21(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP22, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP22(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP23, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP23(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP24, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP24(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP25, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP25(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP26, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP26(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP27, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP27(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP28, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP28(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP29, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP29(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP30, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP30(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP31, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP31(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP32, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP32(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP33, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP33(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP34, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP34(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP35, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP35(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP36, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP36(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP37, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP37(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP38, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP38(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP39, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP39(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP40, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP40(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP41, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP41(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP42, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP42(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP43, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP43(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP44, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP44(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP45, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP45(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP46, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP46(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP47, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP47(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP48, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP48(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP49, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP49(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP50, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP50(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP51, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP51(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP52, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP52(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP53, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP53(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP54, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP54(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP55, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP55(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP56, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP56(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP57, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP57(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP58, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP58(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP59, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP59(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP60, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP60(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP61, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP61(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP62, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP62(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP63, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP63(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP64, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP64(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP65, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP65(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP66, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP66(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP67, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP67(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP68, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP68(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP69, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP69(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP70, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP70(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP71, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP71(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP72, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP72(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP73, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP73(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP74, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP74(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP75, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP75(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP76, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP76(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP77, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP77(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP78, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP78(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP79, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP79(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP80, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP80(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP81, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP81(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP82, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP82(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP83, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP83(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP84, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP84(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP85, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP85(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP86, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP86(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP87, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP87(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP88, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP88(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP89, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP89(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP90, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP90(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP91, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP91(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP92, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP92(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP93, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP93(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP94, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP94(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP95, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP95(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP96, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP96(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP97, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP97(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP98, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP98(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP99, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP99(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP100, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP100(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP101, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP101(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP102, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP102(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP103, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP103(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP104, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP104(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP105, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP105(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP106, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP106(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP107, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP107(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP108, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP108(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP109, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP109(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP110, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP110(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP111, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP111(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP112, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP112(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP113, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP113(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP114, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP114(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP115, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP115(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP116, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP116(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP117, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP117(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP118, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP118(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP119, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP119(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP120, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP120(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP121, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP121(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP122, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP122(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP123, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP123(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP124, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP124(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP125, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP125(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP126, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP126(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP127, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP127(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_STEP128, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_FOR_EACH_STEP128(macro, extraArgs, ...) NESTED_ENUM_INTERNAL_FOR_EACH_CHUNK(macro, extraArgs, __VA_ARGS__) NESTED_ENUM_INTERNAL_FOR_EACH_NEXT(NESTED_ENUM_INTERNAL_FOR_EACH_LIMIT_REACHED, __VA_ARGS__)(macro, extraArgs, NESTED_ENUM_INTERNAL_FOR_EACH_SKIP(__VA_ARGS__))
+
+#define NESTED_ENUM_INTERNAL_PASTE_VAL(value) value, , , 
+#define NESTED_ENUM_INTERNAL_PASTE_ID(id) , id, , 
+#define NESTED_ENUM_INTERNAL_PASTE_TYPE(type) , ,type, 
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_ID(value, id) value, id, , 
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_TYPE(value, type) value, , type, 
+#define NESTED_ENUM_INTERNAL_PASTE_ID_TYPE(id, type) , id, type, 
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_ID_TYPE(value, id, type) value, id, type, 
+// the aliases are all the remaining inputs, kept together in parentheses
+#define NESTED_ENUM_INTERNAL_PASTE_ALIAS(...) , , , (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_ALIAS(value, ...) value, , , (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_ID_ALIAS(id, ...) , id, , (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_TYPE_ALIAS(type, ...) , , type, (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_ID_ALIAS(value, id, ...) value, id, , (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_TYPE_ALIAS(value, type, ...) value, , type, (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_ID_TYPE_ALIAS(id, type, ...) , id, type, (__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_PASTE_VAL_ID_TYPE_ALIAS(value, id, type, ...) value, id, type, (__VA_ARGS__)
 
 // __VA_ARGS__ are the expanded typePack from an enum body definition
 #define NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE(functions, getter, name, ...) NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE1((NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE_CONTINUE, NESTED_ENUM_INTERNAL_SKIP_FIRST_OF_MANY functions), functions, getter, name, __VA_ARGS__)
@@ -1249,47 +3880,46 @@ namespace nested_enum
 
 #define NESTED_ENUM_INTERNAL_GET_ID(...) NESTED_ENUM_INTERNAL_GET_ID1(__VA_ARGS__)
 #define NESTED_ENUM_INTERNAL_GET_ID1(name, ...) NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_GET_ID_FINAL2, NESTED_ENUM_INTERNAL_GET_ID_FINAL1), NESTED_ENUM_INTERNAL_GET_SECOND_OF_MANY, name __VA_OPT__(,) __VA_ARGS__)
-#define NESTED_ENUM_INTERNAL_GET_ID_FINAL1(name, ...) {}
-#define NESTED_ENUM_INTERNAL_GET_ID_FINAL2(name, ...) __VA_ARGS__
+#define NESTED_ENUM_INTERNAL_GET_ID_FINAL1(name, ...) ::nested_enum::detail::no_id{}
+#define NESTED_ENUM_INTERNAL_GET_ID_FINAL2(name, ...) ::nested_enum::fixed_string{ __VA_ARGS__ }
 
-#define NESTED_ENUM_INTERNAL_GET_VAL(...) NESTED_ENUM_INTERNAL_GET_VAL1(__VA_ARGS__)
-#define NESTED_ENUM_INTERNAL_GET_VAL1(name, ...) NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_GET_VAL_FINAL2, NESTED_ENUM_INTERNAL_GET_VAL_FINAL1), NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY, name __VA_OPT__(,) __VA_ARGS__)
-#define NESTED_ENUM_INTERNAL_GET_VAL_FINAL1(name, ...) ::nested_enum::detail::opt<underlying_type>{ false, underlying_type(0) }
-#define NESTED_ENUM_INTERNAL_GET_VAL_FINAL2(name, ...) ::nested_enum::detail::opt<underlying_type>{ true, underlying_type(__VA_ARGS__) }
+#define NESTED_ENUM_INTERNAL_GET_ALIASES(...) NESTED_ENUM_INTERNAL_GET_ALIASES1(__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_GET_ALIASES1(name, ...) NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_GET_ALIASES_FINAL2, NESTED_ENUM_INTERNAL_GET_ALIASES_FINAL1), NESTED_ENUM_INTERNAL_GET_FOURTH_OF_MANY, name __VA_OPT__(,) __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_GET_ALIASES_FINAL1(name, ...) ::nested_enum::detail::aliases<>
+#define NESTED_ENUM_INTERNAL_GET_ALIASES_FINAL2(name, ...) ::nested_enum::detail::aliases<NESTED_ENUM_INTERNAL_DEPAREN(__VA_ARGS__)>
 
-#define NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE(...) NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE1(__VA_ARGS__)
 #define NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE1(name, ...) struct name; friend struct name;                                                               \
     private: using name##_linked_type = NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE_FINAL2, NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE_FINAL1), NESTED_ENUM_INTERNAL_GET_THIRD_OF_MANY, name, __VA_ARGS__); public:
 #define NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE_FINAL1(name, ...) void
 #define NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE_FINAL2(name, ...) __VA_ARGS__
 
-#define NESTED_ENUM_INTERNAL_DEFINE_ENUM(...) NESTED_ENUM_INTERNAL_DEFINE_ENUM1(__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_DEFINE_ENUM(extraArgs, specialisation, ...) NESTED_ENUM_INTERNAL_DEFINE_ENUM1(__VA_ARGS__),
 #define NESTED_ENUM_INTERNAL_DEFINE_ENUM1(name, ...) name NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_DEFINE_ENUM_FINAL2, NESTED_ENUM_INTERNAL_DEFINE_ENUM_FINAL1), NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY, name __VA_OPT__(,) __VA_ARGS__)
 #define NESTED_ENUM_INTERNAL_DEFINE_ENUM_FINAL1(name, ...) 
 #define NESTED_ENUM_INTERNAL_DEFINE_ENUM_FINAL2(name, ...) = __VA_ARGS__
 
-#define NESTED_ENUM_INTERNAL_STRUCT_IDENTITY(typeName) struct typeName
+#define NESTED_ENUM_INTERNAL_DEFINE_FLAG(extraArgs, specialisation, ...) NESTED_ENUM_INTERNAL_DEFINE_FLAG1(__VA_ARGS__),
+#define NESTED_ENUM_INTERNAL_DEFINE_FLAG1(name, ...) name NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_DEFINE_ENUM_FINAL2, NESTED_ENUM_INTERNAL_DEFINE_FLAG_FINAL1), NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY, name __VA_OPT__(,) __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_DEFINE_FLAG_FINAL1(name, ...) = ::nested_enum::detail::flag_value<underlying_type>(InternalFlagIndex::name)
+// only the values without VAL get a bit, so they take consecutive ones
+#define NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX(extraArgs, specialisation, name, ...) NESTED_ENUM_INTERNAL_GET_VAL_ID_TYPE((NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX_FINAL2, NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX_FINAL1), NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY, name __VA_OPT__(,) __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX_FINAL1(name, ...) name,
+#define NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX_FINAL2(name, ...)
 
-// this is where the magic happens, so i'll write down how it works before i forget
-// the way for_each works is through macro deferred expressions and continuous rescanning by EXPAND
-// this however not only rescans the current iteration but also all previous ones and everything inside them
-// in order to avoid rescanning and substituting the deferred NESTED_ENUM_INTERNAL_SETUP calls we need to defer the initial macro call
-// as many times as there are expands - 1, hence the deferStages bit
-// but because after every loop iteration one less expand is left we need to also decrease the number of deferrals
-// during the process multiple deferrals are exhausted so we actually need to add one
-// needs the main for_each macro to pass it the deferStages
-#define NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_WITH_EXTRA_ARGS(macro, deferStages, extraArgs, a1, ...)                                         \
-    macro deferStages (extraArgs, a1, __VA_ARGS__)                                                                                            \
-    __VA_OPT__(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_WITH_EXTRA_ARGS_AGAIN NESTED_ENUM_INTERNAL_PARENS (macro, NESTED_ENUM_INTERNAL_DEFER_ADD(deferStages), extraArgs, __VA_ARGS__))
-#define NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_WITH_EXTRA_ARGS_AGAIN() NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_WITH_EXTRA_ARGS
-
-
-// extraArgs are currently - (parentName), arg - (typeName, (specialisation specifier, ...))
-#define NESTED_ENUM_INTERNAL_STRUCT_PREP(extraArgs, arg, ...) NESTED_ENUM_INTERNAL_STRUCT_PREP1(NESTED_ENUM_INTERNAL_DEPAREN(extraArgs), NESTED_ENUM_INTERNAL_DEPAREN(arg))
-#define NESTED_ENUM_INTERNAL_STRUCT_PREP1(parent, ...) NESTED_ENUM_INTERNAL_STRUCT_PREP2(parent, __VA_ARGS__)
-#define NESTED_ENUM_INTERNAL_STRUCT_PREP2(parent, typeName, ...) NESTED_ENUM_INTERNAL_STRUCT_PREP3(parent, typeName, NESTED_ENUM_INTERNAL_DEPAREN(__VA_ARGS__))
-#define NESTED_ENUM_INTERNAL_STRUCT_PREP3(parent, typeName, treeCall, ...) NESTED_ENUM_INTERNAL_STRUCT_PREP_CALL(parent, typeName, treeCall __VA_OPT__(,) __VA_ARGS__)
-#define NESTED_ENUM_INTERNAL_STRUCT_PREP_CALL(parent, typeName, treeCall, ...)  NESTED_ENUM_INTERNAL_TREE_##treeCall(parent, typeName, __VA_ARGS__)
+// only the name and id are needed here, the value is taken from the enumerator itself
+#define NESTED_ENUM_INTERNAL_DEFINE_ENTRY(extraArgs, specialisation, name, ...) , ::nested_enum::detail::entry<struct name, name,                 \
+    NESTED_ENUM_INTERNAL_STRINGIFY(name), NESTED_ENUM_INTERNAL_GET_ID(name __VA_OPT__(,) __VA_ARGS__)>
+
+#define NESTED_ENUM_INTERNAL_DEFINE_ALIASES(extraArgs, specialisation, name, ...) , NESTED_ENUM_INTERNAL_GET_ALIASES(name __VA_OPT__(,) __VA_ARGS__)
+
+// forward declares the entry type, defines its linked type and (if needed) the entry type itself
+#define NESTED_ENUM_INTERNAL_DECLARE_ENTRY(extraArgs, specialisation, name, ...)                                                              \
+    NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE1(name, __VA_ARGS__) NESTED_ENUM_INTERNAL_STRUCT_PREP(extraArgs, name, specialisation)
+
+// extraArgs are currently - (parentName, parentDepth), specialisation - (specialisation specifier, ...)
+#define NESTED_ENUM_INTERNAL_STRUCT_PREP(extraArgs, typeName, ...) NESTED_ENUM_INTERNAL_STRUCT_PREP1(NESTED_ENUM_INTERNAL_DEPAREN(extraArgs), typeName, NESTED_ENUM_INTERNAL_DEPAREN(__VA_ARGS__))
+#define NESTED_ENUM_INTERNAL_STRUCT_PREP1(...) NESTED_ENUM_INTERNAL_STRUCT_PREP_CALL(__VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_STRUCT_PREP_CALL(parent, depth, typeName, treeCall, ...)  NESTED_ENUM_INTERNAL_TREE_##treeCall(parent, depth, typeName, __VA_ARGS__)
 
 
 #define NESTED_ENUM_INTERNAL_DEFINE_CONSTRUCTORS(typeName)                                                                                    \
@@ -1313,7 +3943,7 @@ namespace nested_enum
     static constexpr auto internalGlobalPrefix = ::nested_enum::detail::get_prefix<                                                           \
       __VA_OPT__(NESTED_ENUM_INTERNAL_SKIP_FIRST_OF_MANY(__VA_ARGS__))>();                                                                    \
     static constexpr bool isLeaf = isLeafValue;                                                                                               \
-    static constexpr auto internalName = create_name(::nested_enum::fixed_string{ #typeName });
+    NESTED_ENUM_INTERNAL_IF_NAMES(static constexpr auto internalName = create_name(::nested_enum::fixed_string{ #typeName });)
 
 #define NESTED_ENUM_INTERNAL_DEFINITION_(isLeafValue, parent, typeName, ...)                                                                  \
   struct typeName : public ::nested_enum::nested_enum<struct typeName, struct parent>                                                         \
@@ -1323,7 +3953,7 @@ namespace nested_enum
     using linked_type = parent::typeName##_linked_type;                                                                                       \
                                                                                                                                               \
     static constexpr bool isLeaf = isLeafValue;                                                                                               \
-    static constexpr auto internalName = create_name(::nested_enum::fixed_string{ #typeName });                                               \
+    NESTED_ENUM_INTERNAL_IF_NAMES(static constexpr auto internalName = create_name(::nested_enum::fixed_string{ #typeName });)                \
     static constexpr auto value() { struct parent result = parent::typeName; return result; }
 
 #define NESTED_ENUM_INTERNAL_DEFINITION_FROM(isLeafValue, parent, typeName, ...)                                                              \
@@ -1334,11 +3964,11 @@ namespace nested_enum
     using linked_type = parent::typeName##_linked_type;                                                                                       \
                                                                                                                                               \
     static constexpr bool isLeaf = isLeafValue;                                                                                               \
-    static constexpr auto internalName = create_name(::nested_enum::fixed_string{ #typeName });                                               \
+    NESTED_ENUM_INTERNAL_IF_NAMES(static constexpr auto internalName = create_name(::nested_enum::fixed_string{ #typeName });)                \
     static constexpr auto value() { struct parent result = parent::typeName; return result; }
 
 
-#define NESTED_ENUM_INTERNAL_BODY_(typeName, ...)                                                                                             \
+#define NESTED_ENUM_INTERNAL_BODY_(depth, typeName, ...)                                                                                       \
                                                                                                                                               \
     enum Value : underlying_type { };                                                                                                         \
     Value internalValue;                                                                                                                      \
@@ -1349,60 +3979,112 @@ namespace nested_enum
                                                                                                                                               \
     static constexpr ::std::array<Value, 0> enumValues{};                                                                                     \
                                                                                                                                               \
-    static constexpr ::std::array<::std::optional<std::string_view>, 0> enumIds{};                                                            \
+    NESTED_ENUM_INTERNAL_IF_IDS(static constexpr ::std::array<::std::optional<std::string_view>, 0> enumIds{};)                               \
                                                                                                                                               \
     static constexpr ::nested_enum::detail::type_list<> subtypes{};                                                                           \
   };
 
-#define NESTED_ENUM_INTERNAL_BODY_CONTINUE(typeName, bodyArguments, structsArguments)                                                         \
+#define NESTED_ENUM_INTERNAL_BODY_CONTINUE(depth, typeName, bodyArguments, structsArguments)                                                   \
+                                                                                                                                              \
+    enum Value : underlying_type { NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_DEFINE_ENUM, (), (),                                    \
+      NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)) };                                                                                         \
+    NESTED_ENUM_INTERNAL_BODY_ENTRIES(depth, typeName, bodyArguments, structsArguments)
+
+// the bit of every value without VAL is its position in a scoped enum of only those names
+#define NESTED_ENUM_INTERNAL_BODY_FLAGS(depth, typeName, bodyArguments, structsArguments)                                                      \
+                                                                                                                                              \
+    enum class InternalFlagIndex { NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_DEFINE_FLAG_INDEX, (), (),                              \
+      NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)) internalFlagCount };                                                                       \
+    static_assert(::std::size_t(InternalFlagIndex::internalFlagCount) <= sizeof(underlying_type) * 8,                                        \
+      "NESTED_ENUM_FLAGS has more values without VAL than bits in its underlying type");                                                      \
+    enum Value : underlying_type { NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_DEFINE_FLAG, (), (),                                    \
+      NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)) };                                                                                         \
+    static constexpr bool isFlags = true;                                                                                                     \
                                                                                                                                               \
-    enum Value : underlying_type { NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE,                                       \
-      NESTED_ENUM_INTERNAL_DEFINE_ENUM, (,), NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)) };                                                  \
+    friend constexpr auto operator|(Value left, Value right) noexcept { return ::nested_enum::flag_mask<typeName>(left) | right; }            \
+    friend constexpr auto operator&(Value left, Value right) noexcept { return ::nested_enum::flag_mask<typeName>(left) & right; }            \
+    friend constexpr auto operator^(Value left, Value right) noexcept { return ::nested_enum::flag_mask<typeName>(left) ^ right; }            \
+    friend constexpr auto operator~(Value value) noexcept { return ~::nested_enum::flag_mask<typeName>(value); }                              \
+                                                                                                                                              \
+    NESTED_ENUM_INTERNAL_BODY_ENTRIES(depth, typeName, bodyArguments, structsArguments)
+
+#define NESTED_ENUM_INTERNAL_BODY_ENTRIES(depth, typeName, bodyArguments, structsArguments)                                                    \
     Value internalValue;                                                                                                                      \
                                                                                                                                               \
     NESTED_ENUM_INTERNAL_DEFINE_CONSTRUCTORS(typeName)                                                                                        \
                                                                                                                                               \
     constexpr operator Value() const noexcept { return internalValue; }                                                                       \
                                                                                                                                               \
-    static constexpr auto enumValues = ::nested_enum::detail::get_array_of_values<Value, underlying_type,                                     \
-      NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE,                                                                    \
-        NESTED_ENUM_INTERNAL_GET_VAL, (,), NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments))>();                                                   \
+    NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_DECLARE_ENTRY, (typeName, depth), structsArguments,                                      \
+      NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments))                                                                                            \
                                                                                                                                               \
-    static constexpr auto enumNames = ::nested_enum::detail::get_string_values<internalName,                                                  \
-      NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE, NESTED_ENUM_INTERNAL_GET_TYPE_STRING, (,),                         \
-        NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments))>();									                                                                    \
+    static constexpr auto internalEntries = ::nested_enum::detail::entries<Value                                                              \
+      NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_DEFINE_ENTRY, (), (), NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments))>{};               \
                                                                                                                                               \
-    static constexpr auto enumIds = ::std::to_array<::std::optional<::std::string_view>>                                                      \
-      ({ NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE, NESTED_ENUM_INTERNAL_GET_ID, (,),                               \
-        NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)) });                                                                                      \
+    static constexpr auto enumValues = ::nested_enum::detail::get_array_of_values(internalEntries);                                           \
                                                                                                                                               \
-    NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE, NESTED_ENUM_INTERNAL_DEFINE_LINKED_TYPE, (),                         \
-      NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments))                                                                                            \
+    NESTED_ENUM_INTERNAL_IF_NAMES(static constexpr auto enumNames = ::nested_enum::detail::get_string_values<internalName>(internalEntries);) \
+    NESTED_ENUM_INTERNAL_IF_NAMES(static constexpr auto internalAliases = ::nested_enum::detail::entry_aliases<Value                          \
+      NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_DEFINE_ALIASES, (), (), NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments))>{};)            \
                                                                                                                                               \
-    NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE_WITH_EXTRA_ARGS, NESTED_ENUM_INTERNAL_STRUCT_PREP,                    \
-      NESTED_ENUM_INTERNAL_DEFER_ADD(NESTED_ENUM_INTERNAL_DEFER()), (typeName),                                                               \
-      NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_INTERLEAVE_TWO, structsArguments, NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)))      \
                                                                                                                                               \
-    static constexpr ::nested_enum::detail::type_list<NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE,                    \
-      NESTED_ENUM_INTERNAL_STRUCT_IDENTITY, (,), NESTED_ENUM_INTERNAL_FOR_EACH(NESTED_ENUM_INTERNAL_GET_FIRST_OF_ONE,                         \
-      NESTED_ENUM_INTERNAL_GET_TYPE, (,), NESTED_ENUM_INTERNAL_DEPAREN(bodyArguments)))> subtypes{};                                          \
+    NESTED_ENUM_INTERNAL_IF_IDS(static constexpr auto enumIds = ::nested_enum::detail::get_array_of_ids(internalEntries);)                    \
+                                                                                                                                              \
+    static constexpr auto subtypes = ::nested_enum::detail::get_subtypes(internalEntries);                                                    \
   };
 
 
-#define NESTED_ENUM_INTERNAL_SETUP(definitionType, definitionArguments, ...)                                                                  \
+// depth is the level of the node below the root of its NESTED_ENUM (or NESTED_ENUM_FROM)
+#define NESTED_ENUM_INTERNAL_SETUP(depth, definitionType, definitionArguments, ...)                                                           \
+  NESTED_ENUM_INTERNAL_SETUP_BODY(CONTINUE, depth, definitionType, definitionArguments, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_SETUP_FLAGS(depth, definitionType, definitionArguments, ...)                                                     \
+  NESTED_ENUM_INTERNAL_SETUP_BODY(FLAGS, depth, definitionType, definitionArguments, __VA_ARGS__)
+
+#define NESTED_ENUM_INTERNAL_SETUP_BODY(bodyType, depth, definitionType, definitionArguments, ...)                                            \
   NESTED_ENUM_INTERNAL_DEFINITION_##definitionType definitionArguments                                                                        \
-  NESTED_ENUM_INTERNAL_CONDITIONALLY_CALL(NESTED_ENUM_INTERNAL_BODY_, CONTINUE,                                                               \
-    (NESTED_ENUM_INTERNAL_GET_THIRD_OF_MANY definitionArguments, NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY(__VA_ARGS__),                         \
+  NESTED_ENUM_INTERNAL_CONDITIONALLY_CALL(NESTED_ENUM_INTERNAL_BODY_, bodyType,                                                               \
+    (depth, NESTED_ENUM_INTERNAL_GET_THIRD_OF_MANY definitionArguments, NESTED_ENUM_INTERNAL_GET_FIRST_OF_MANY(__VA_ARGS__),                  \
       (NESTED_ENUM_INTERNAL_SKIP_FIRST_OF_MANY(__VA_ARGS__))), __VA_ARGS__)
 
 #define NESTED_ENUM_INTERNAL_SETUP_AGAIN() NESTED_ENUM_INTERNAL_SETUP
+#define NESTED_ENUM_INTERNAL_SETUP_FLAGS_AGAIN() NESTED_ENUM_INTERNAL_SETUP_FLAGS
 
+// child nodes can't be defined while their parent is being expanded, because all the macros used for defining are disabled
+// so the SETUP call is deferred until the next rescan from NESTED_ENUM_INTERNAL_EXPAND, where it can be expanded again
 // defines an outer node inside a tree
-#define NESTED_ENUM_INTERNAL_TREE_(parent, typeName, ...) NESTED_ENUM_INTERNAL_SETUP_AGAIN NESTED_ENUM_INTERNAL_PARENS (, (true, parent, typeName))
+#define NESTED_ENUM_INTERNAL_TREE_(parent, depth, typeName, ...) NESTED_ENUM_INTERNAL_CHILD_OF_##depth(NESTED_ENUM_INTERNAL_SETUP_AGAIN, , (true, parent, typeName))
 // defines an inner node inside a tree
-#define NESTED_ENUM_INTERNAL_TREE_ENUM(parent, typeName, enumDefinition, ...) NESTED_ENUM_INTERNAL_SETUP_AGAIN NESTED_ENUM_INTERNAL_PARENS (, (false, parent, NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_TREE_ENUM(parent, depth, typeName, enumDefinition, ...) NESTED_ENUM_INTERNAL_CHILD_OF_##depth(NESTED_ENUM_INTERNAL_SETUP_AGAIN, , (false, parent, NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__)
+// defines an inner node inside a tree whose values are bit flags
+#define NESTED_ENUM_INTERNAL_TREE_FLAGS(parent, depth, typeName, enumDefinition, ...) NESTED_ENUM_INTERNAL_CHILD_OF_##depth(NESTED_ENUM_INTERNAL_SETUP_FLAGS_AGAIN, , (false, parent, NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__)
 // only forward declares a node because the user wants to define it later 
-#define NESTED_ENUM_INTERNAL_TREE_DEFER(parent, typeName, ...) 
+#define NESTED_ENUM_INTERNAL_TREE_DEFER(parent, depth, typeName, ...) 
+
+// the deferred SETUP call of a child of a node at the given depth, NESTED_ENUM_INTERNAL_EXPAND has enough rescans for
+// nodes up to a depth of 21 so children of those fail the static_assert in detail::depth_limit instead, which leaves
+// the rest of the tree intact and makes it the only error
+#define NESTED_ENUM_INTERNAL_CHILD_OF_0(again, ...) again NESTED_ENUM_INTERNAL_PARENS (1, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_1(again, ...) again NESTED_ENUM_INTERNAL_PARENS (2, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_2(again, ...) again NESTED_ENUM_INTERNAL_PARENS (3, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_3(again, ...) again NESTED_ENUM_INTERNAL_PARENS (4, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_4(again, ...) again NESTED_ENUM_INTERNAL_PARENS (5, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_5(again, ...) again NESTED_ENUM_INTERNAL_PARENS (6, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_6(again, ...) again NESTED_ENUM_INTERNAL_PARENS (7, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_7(again, ...) again NESTED_ENUM_INTERNAL_PARENS (8, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_8(again, ...) again NESTED_ENUM_INTERNAL_PARENS (9, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_9(again, ...) again NESTED_ENUM_INTERNAL_PARENS (10, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_10(again, ...) again NESTED_ENUM_INTERNAL_PARENS (11, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_11(again, ...) again NESTED_ENUM_INTERNAL_PARENS (12, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_12(again, ...) again NESTED_ENUM_INTERNAL_PARENS (13, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_13(again, ...) again NESTED_ENUM_INTERNAL_PARENS (14, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_14(again, ...) again NESTED_ENUM_INTERNAL_PARENS (15, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_15(again, ...) again NESTED_ENUM_INTERNAL_PARENS (16, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_16(again, ...) again NESTED_ENUM_INTERNAL_PARENS (17, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_17(again, ...) again NESTED_ENUM_INTERNAL_PARENS (18, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_18(again, ...) again NESTED_ENUM_INTERNAL_PARENS (19, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_19(again, ...) again NESTED_ENUM_INTERNAL_PARENS (20, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_20(again, ...) again NESTED_ENUM_INTERNAL_PARENS (21, __VA_ARGS__)
+#define NESTED_ENUM_INTERNAL_CHILD_OF_21(again, ...) static_assert(::nested_enum::detail::depth_limit<false>::value);
 
 //==================================================================================
 
@@ -1436,11 +4118,196 @@ namespace nested_enum
 //    
 //    NESTED_ENUM_FROM(Vehicle::Land, Motorcycle, (Scooter, Cruiser, Sport, OffRoad))
 //
-#define NESTED_ENUM(enumDefinition, ...) NESTED_ENUM_INTERNAL_EXPAND_SECOND(NESTED_ENUM_INTERNAL_SETUP(NO_PARENT, (false, (), NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__))
+#define NESTED_ENUM(enumDefinition, ...) NESTED_ENUM_INTERNAL_EXPAND(NESTED_ENUM_INTERNAL_SETUP(0, NO_PARENT, (false, (), NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__))
 
 // defines a deferred enum from a tree definition; needs to fill out the parent explicitly
 // see NESTED_ENUM macro for more information
-#define NESTED_ENUM_FROM(parent, enumDefinition, ...) NESTED_ENUM_INTERNAL_EXPAND_SECOND(NESTED_ENUM_INTERNAL_SETUP(FROM, (false, parent, NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__))
+#define NESTED_ENUM_FROM(parent, enumDefinition, ...) NESTED_ENUM_INTERNAL_EXPAND(NESTED_ENUM_INTERNAL_SETUP(0, FROM, (false, parent, NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__))
+
+
+// defines a (root) enum whose values are bit flags, values without VAL are assigned consecutive bits in declaration order
+// the values can be combined into a nested_enum::flag_mask with |, &, ^ and ~
+// children are defined like in NESTED_ENUM, inner nodes can also be bit flags with (FLAGS, child definition, child entries, ...)
+//
+// Example:
+//
+//    NESTED_ENUM_FLAGS((Permission, std::uint8_t), (Read, Write, Exec))
+//
+//    auto mask = Permission::Read | Permission::Exec;                                  // Read = 1, Write = 2, Exec = 4
+//    auto parsed = nested_enum::flag_mask<Permission>::parse("Read|Exec");             // == mask
+//
+#define NESTED_ENUM_FLAGS(enumDefinition, ...) NESTED_ENUM_INTERNAL_EXPAND(NESTED_ENUM_INTERNAL_SETUP_FLAGS(0, NO_PARENT, (false, (), NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__))
+
+// defines a deferred enum whose values are bit flags from a tree definition; needs to fill out the parent explicitly
+// see NESTED_ENUM_FLAGS and NESTED_ENUM macros for more information
+#define NESTED_ENUM_FLAGS_FROM(parent, enumDefinition, ...) NESTED_ENUM_INTERNAL_EXPAND(NESTED_ENUM_INTERNAL_SETUP_FLAGS(0, FROM, (false, parent, NESTED_ENUM_INTERNAL_DEPAREN(enumDefinition)), __VA_ARGS__))
+
+
+#endif
+
+// g++ 12 doesn't allow specializing std templates inside a named module, so nested_enum.cppm leaves these out
+// and they are kept out of the include guard for importers to include them after the import with
+// NESTED_ENUM_STD_SPECIALIZATIONS_ONLY defined (see README)
+#if (defined(NESTED_ENUM_STD_SPECIALIZATIONS_ONLY) || (!defined(NESTED_ENUM_MACROS_ONLY) && !defined(NESTED_ENUM_NO_STD_SPECIALIZATIONS))) \
+  && !defined(NESTED_ENUM_STD_SPECIALIZATIONS_INCLUDED)
+#define NESTED_ENUM_STD_SPECIALIZATIONS_INCLUDED
+
+// hashes only the integer, std::hash of tree_codec<E>::value_type works through this as well
+template<nested_enum::NestedEnum E>
+struct std::hash<E>
+{
+  std::size_t operator()(const E &value) const noexcept
+  {
+    return std::hash<typename E::underlying_type>{}(value.enum_integer());
+  }
+};
+
+#ifdef __cpp_lib_format
+
+namespace nested_enum::detail
+{
+  // the format spec is the one of std::string_view followed by
+  //   n - full name (default), c - clean name, i - id (empty if there is none)
+  // or the one of the underlying integer type ending in d
+  // names and ids are written directly from the static string tables, nothing is allocated
+  template<typename E, typename Integer>
+  struct enum_formatter
+  {
+    // the type is peeled off the end of the spec and the rest is parsed by the string or integer formatter
+    // nested replacement fields (dynamic width and precision) take their argument ids from context and are
+    // handed on with explicit ids, so automatic numbering and the format string checks keep working
+    // their arguments have to be integers, which is checked here where the library allows it (C++26) and
+    // otherwise when formatting, like the standard formatters do
+    constexpr auto parse(std::format_parse_context &context) -> std::format_parse_context::iterator
+    {
+      auto begin = context.begin();
+      auto end = begin;
+      std::size_t depth = 0;
+      for (; end != context.end() && (*end != '}' || depth != 0); ++end)
+      {
+        if (*end == '{')
+          ++depth;
+        else if (*end == '}')
+          --depth;
+      }
+      if (depth != 0)
+        throw std::format_error("nested_enum: unmatched '{' in format spec");
+
+      auto specEnd = end;
+      if (begin != end && (end[-1] == 'n' || end[-1] == 'c' || end[-1] == 'i'))
+        type = *--specEnd;
+      else if (begin != end && end[-1] == 'd')
+        type = 'd';
 
+      if ((type == 'n' || type == 'c') && !hasNames<E>)
+        throw std::format_error("nested_enum: names were left out with NESTED_ENUM_NO_NAMES");
+      if (type == 'i' && !hasIds<E>)
+        throw std::format_error("nested_enum: ids were left out with NESTED_ENUM_NO_IDS");
+
+      std::array<char, 64> buffer{};
+      std::size_t size = 0;
+      std::size_t argumentCount = 0;
+      auto write = [&](char character)
+      {
+        if (size == buffer.size())
+          throw std::format_error("nested_enum: format spec is too long");
+        buffer[size++] = character;
+      };
+
+      for (auto current = begin; current != specEnd; ++current)
+      {
+        write(*current);
+        if (*current != '{')
+          continue;
+
+        std::size_t id = 0;
+        if (*++current == '}')
+          id = context.next_arg_id();
+        else
+        {
+          for (; *current >= '0' && *current <= '9'; ++current)
+            id = id * 10 + (std::size_t)(*current - '0');
+          if (*current != '}')
+            throw std::format_error("nested_enum: invalid argument id in format spec");
+          context.check_arg_id(id);
+        }
+      #if __cpp_lib_format >= 202305L
+        context.check_dynamic_spec_integral(id);
+      #endif
+        if (id >= argumentCount)
+          argumentCount = id + 1;
+
+        char digits[20]{};
+        std::size_t count = 0;
+        do
+          digits[count++] = (char)('0' + id % 10);
+        while ((id /= 10) != 0);
+        while (count != 0)
+          write(digits[--count]);
+        write('}');
+      }
+
+      // the ids were checked against the real arguments above, the spec only needs as many as it refers to
+      std::format_parse_context spec{ std::string_view(buffer.data(), size), argumentCount };
+      auto parsed = (type == 'd') ? integers.parse(spec) : strings.parse(spec);
+      if (parsed != spec.end())
+        throw std::format_error("nested_enum: invalid format spec");
+
+      return end;
+    }
+
+    template<typename T, typename FormatContext>
+    auto format_value(const T &value, FormatContext &context) const
+    {
+      if (type == 'd')
+        return integers.format((Integer)value.enum_integer(), context);
+
+      std::string_view string{};
+      if constexpr (hasNames<E>)
+        if (type == 'n' || type == 'c')
+          string = value.enum_name(type == 'c');
+      if constexpr (hasIds<E>)
+        if (type == 'i')
+          string = value.enum_id().value_or(std::string_view{});
+
+      return strings.format(string, context);
+    }
+
+    std::formatter<std::string_view> strings{};
+    std::formatter<Integer> integers{};
+    char type = hasNames<E> ? 'n' : 'd';
+  };
+}
+
+template<nested_enum::NestedEnum E>
+struct std::formatter<E> : nested_enum::detail::enum_formatter<E, typename E::underlying_type>
+{
+  template<typename FormatContext>
+  auto format(const E &value, FormatContext &context) const
+  {
+    return this->format_value(value, context);
+  }
+};
+
+// all alternatives are formatted with the same spec, std::monostate is formatted as an empty string
+// (padded by the spec unless it is an integer spec, which the string formatter can't take)
+template<nested_enum::NestedEnum T, nested_enum::NestedEnum ... Ts>
+struct std::formatter<std::variant<std::monostate, T, Ts...>> :
+  nested_enum::detail::enum_formatter<T, std::common_type_t<typename T::underlying_type, typename Ts::underlying_type...>>
+{
+  template<typename FormatContext>
+  auto format(const std::variant<std::monostate, T, Ts...> &value, FormatContext &context) const
+  {
+    return std::visit([&]<typename U>(const U &alternative)
+      {
+        if constexpr (std::is_same_v<U, std::monostate>)
+          return this->strings.format(std::string_view{}, context);
+        else
+          return this->format_value(alternative, context);
+      }, value);
+  }
+};
+
+#endif
 
 #endif
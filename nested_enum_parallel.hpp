@@ -0,0 +1,320 @@
+#ifndef NESTED_ENUM_PARALLEL_HPP
+#define NESTED_ENUM_PARALLEL_HPP
+
+// the parts of nested_enum that need threads, kept out of nested_enum.hpp so that only code that uses them pays for
+// including <thread>, <atomic> and <mutex>
+//   parse_bulk         - converts a column of names to values on several threads
+//   extension_registry - runtime values under the values of an enum, lookups never block while they are changed
+
+#include "nested_enum.hpp"
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if !defined(NESTED_ENUM_MACROS_ONLY) && !defined(NESTED_ENUM_STD_SPECIALIZATIONS_ONLY)
+
+namespace nested_enum
+{
+  namespace detail
+  {
+    // parses the names in [begin, end), begin is a multiple of 64 so that every call owns whole words of errors
+    template<typename E, bool clean>
+    constexpr std::size_t parse_range(const auto &input, std::span<typename E::Value> output,
+      std::span<std::uint64_t> errors, std::size_t begin, std::size_t end) noexcept
+    {
+      std::size_t failed = 0;
+      for (std::size_t word = begin; word < end; word += 64)
+      {
+        std::uint64_t bits = 0;
+        for (std::size_t i = word; i < end && i < word + 64; ++i)
+        {
+          std::size_t position = E::enumValues.size();
+          nameIndex<E, clean>.find(std::string_view(input[i]), [&](std::size_t match) { position = match; });
+
+          if (position != E::enumValues.size())
+            output[i] = E::enumValues[position];
+          else
+          {
+            bits |= std::uint64_t(1) << (i - word);
+            ++failed;
+          }
+        }
+        errors[word / 64] = bits;
+      }
+      return failed;
+    }
+
+    // runs every chunk but the last on a thread of its own and the last one on the calling thread
+    template<typename E, bool clean>
+    std::size_t parse_chunks(const auto &input, std::span<typename E::Value> output,
+      std::span<std::uint64_t> errors, std::size_t chunk, std::size_t chunks, std::size_t chunkSize)
+    {
+      std::size_t begin = chunk * chunkSize;
+      std::size_t end = (begin + chunkSize < std::size(input)) ? begin + chunkSize : std::size(input);
+      if (chunk + 1 == chunks)
+        return parse_range<E, clean>(input, output, errors, begin, end);
+
+      std::size_t failed = 0;
+      std::jthread thread{ [&]() { failed = parse_range<E, clean>(input, output, errors, begin, end); } };
+      std::size_t failedAfter = parse_chunks<E, clean>(input, output, errors, chunk + 1, chunks, chunkSize);
+      thread.join();
+      return failed + failedAfter;
+    }
+  }
+
+  // converts every name in input (anything convertible to std::string_view) to a value of E and writes it
+  // to the same position in output, names are the full ones or the clean ones if clean is true
+  // names that aren't part of E leave their output as is and set their bit in errors (bit i % 64 of errors[i / 64])
+  // the work is split evenly over the given number of threads, 0 uses std::thread::hardware_concurrency()
+  // returns how many names couldn't be converted, or nothing if output or errors are too small
+  template<NestedEnum E, bool clean = false> requires detail::hasNames<E>
+  auto parse_bulk(const auto &input, std::span<typename E::Value> output, std::span<std::uint64_t> errors,
+    std::size_t threads = 1) -> std::optional<std::size_t>
+  {
+    std::size_t size = std::size(input);
+    if (output.size() < size || errors.size() < (size + 63) / 64)
+      return {};
+
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+
+    // chunks are whole words of errors
+    std::size_t words = (size + 63) / 64;
+    std::size_t chunks = (threads < words) ? threads : words;
+    if (chunks <= 1)
+      return detail::parse_range<E, clean>(input, output, errors, 0, size);
+
+    std::size_t chunkSize = (words + chunks - 1) / chunks * 64;
+    chunks = (size + chunkSize - 1) / chunkSize;
+    return detail::parse_chunks<E, clean>(input, output, errors, 0, chunks, chunkSize);
+  }
+
+  namespace detail
+  {
+    // true if name is the full name or an alias of a value anywhere in the subtree of E
+    template<typename E>
+    constexpr bool is_name_in_subtree(std::string_view name)
+    {
+      if constexpr (!is_complete_type_v<E>)
+        return false;
+      else if constexpr (E::isLeaf || !hasNames<E>)
+        return false;
+      else
+      {
+        if (find_string<E, false>(name) != E::enumValues.size())
+          return true;
+
+        return []<typename ... Ts>(std::string_view name, type_list<Ts...>)
+        {
+          return (false || ... || is_name_in_subtree<Ts>(name));
+        }(name, E::subtypes);
+      }
+    }
+
+    // reader slot of the calling thread in every extension_registry, handed out round robin so threads rarely share one
+    inline std::size_t reader_slot() noexcept
+    {
+      static std::atomic<std::size_t> next{ 0 };
+      thread_local std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+      return slot;
+    }
+  }
+
+  // runtime registry of extra leaf values under the values of E, for subtrees that are only known at load time
+  // (e.g. values that plugins attach under a deferred node), the full name of an extension is the full name of
+  // its parent value followed by "::" and its own name
+  // lookups never block: readers only announce themselves on a counter of their thread's slot while they use the
+  // current snapshot, writers are serialised, publish a modified copy of the snapshot and delete the old one after
+  // two grace periods
+  template<NestedEnum E> requires detail::hasNames<E>
+  class extension_registry
+  {
+  public:
+    // key is unique for the lifetime of the registry
+    struct extension
+    {
+      typename E::Value parent;
+      std::uint64_t key = 0;
+    };
+
+    extension_registry() = default;
+    extension_registry(const extension_registry &) = delete;
+    extension_registry &operator=(const extension_registry &) = delete;
+    ~extension_registry() { delete current.load(); }
+
+    // adds a value under parent, returns its key or nothing if parent isn't a value of E or the name is taken,
+    // either by another extension or by a value or alias in the subtree of E
+    auto add(typename E::Value parent, std::string_view name) -> std::optional<std::uint64_t>
+    {
+      auto parentName = E::enum_name(E{ parent });
+      if (!parentName.has_value() || name.empty())
+        return {};
+
+      std::string fullName;
+      fullName.reserve(parentName->size() + 2 + name.size());
+      fullName.append(*parentName).append("::").append(name);
+      if (detail::is_name_in_subtree<E>(fullName))
+        return {};
+
+      std::lock_guard lock{ writer };
+      const snapshot *old = current.load();
+      if (old != nullptr && old->find(fullName) != old->extensions.size())
+        return {};
+
+      auto updated = (old != nullptr) ? std::make_unique<snapshot>(*old) : std::make_unique<snapshot>();
+      std::uint64_t key = nextKey++;
+      updated->extensions.push_back({ { parent, key }, std::move(fullName), parentName->size() + 2 });
+      publish(std::move(updated), old);
+      return key;
+    }
+    // removes the extension with the given key, returns false if there is none
+    bool remove(std::uint64_t key)
+    {
+      std::lock_guard lock{ writer };
+      const snapshot *old = current.load();
+      if (old == nullptr)
+        return false;
+
+      auto updated = std::make_unique<snapshot>(*old);
+      std::erase_if(updated->extensions, [&](const auto &stored) { return stored.value.key == key; });
+      if (updated->extensions.size() == old->extensions.size())
+        return false;
+
+      publish(std::move(updated), old);
+      return true;
+    }
+
+    // finds an extension by its full name
+    auto find(std::string_view fullName) const noexcept -> std::optional<extension>
+    {
+      return read([&](const snapshot &values) -> std::optional<extension>
+        {
+          std::size_t position = values.find(fullName);
+          if (position == values.extensions.size())
+            return {};
+          return values.extensions[position].value;
+        });
+    }
+    // calls function with the extension, its full name and its clean name for every extension under parent
+    // in the order they were added, the names are only valid during the call
+    // the extensions are copied out first, so function can add and remove extensions (publishing waits for every
+    // reader to leave, which a function called during the read would never do)
+    void for_each(typename E::Value parent, auto &&function) const
+    {
+      auto matches = read([&](const snapshot &values)
+        {
+          std::vector<typename snapshot::stored> result;
+          for (const auto &stored : values.extensions)
+            if (stored.value.parent == parent)
+              result.push_back(stored);
+          return result;
+        });
+
+      for (const auto &stored : matches)
+        function(stored.value, std::string_view{ stored.name }, std::string_view{ stored.name }.substr(stored.cleanOffset));
+    }
+    std::size_t size() const noexcept
+    {
+      return read([](const snapshot &values) { return values.extensions.size(); });
+    }
+
+  private:
+    // immutable once published
+    struct snapshot
+    {
+      struct stored
+      {
+        extension value;
+        std::string name;
+        std::size_t cleanOffset = 0;
+      };
+
+      // returns the position of the extension, or the number of extensions if there is none
+      std::size_t find(std::string_view fullName) const noexcept
+      {
+        if (slots.empty())
+          return extensions.size();
+
+        std::uint64_t hash = detail::hash_string(fullName);
+        for (std::size_t i = (std::size_t)hash & (slots.size() - 1); slots[i] != 0; i = (i + 1) & (slots.size() - 1))
+          if (extensions[slots[i] - 1].name == fullName)
+            return slots[i] - 1;
+
+        return extensions.size();
+      }
+
+      // open addressing over the full names, one past the position of the extension and 0 for empty slots
+      void rebuild() noexcept
+      {
+        slots.assign(std::bit_ceil(extensions.size() * 2 + 1), 0);
+        for (std::size_t position = 0; position < extensions.size(); ++position)
+        {
+          std::size_t i = (std::size_t)detail::hash_string(extensions[position].name) & (slots.size() - 1);
+          while (slots[i] != 0)
+            i = (i + 1) & (slots.size() - 1);
+          slots[i] = position + 1;
+        }
+      }
+
+      std::vector<stored> extensions{};
+      std::vector<std::size_t> slots{};
+    };
+
+    // calls function with the current snapshot, which can't be deleted until the reader has left its counter
+    // the epoch only picks the counter, it doesn't order anything
+    template<typename Function>
+    auto read(Function &&function) const
+    {
+      static const snapshot empty{};
+
+      struct reader
+      {
+        ~reader() { counter.fetch_sub(1, std::memory_order_release); }
+        std::atomic<std::size_t> &counter;
+      } guard{ readers[detail::reader_slot() % readers.size()].counters[epoch.load(std::memory_order_relaxed) & 1] };
+
+      guard.counter.fetch_add(1, std::memory_order_acquire);
+      const snapshot *values = current.load(std::memory_order_acquire);
+      return function((values != nullptr) ? *values : empty);
+    }
+
+    // the writer checks every counter with a read-modify-write after publishing, a reader whose increment comes
+    // after that check synchronises with it and loads the new snapshot, and one whose increment comes before has
+    // to be gone for the check to read 0, its release decrement then orders its reads before the delete
+    // flipping the epoch between the two halves of the counters lets new readers move on while the old ones drain
+    void publish(std::unique_ptr<snapshot> updated, const snapshot *old)
+    {
+      updated->rebuild();
+      current.store(updated.release(), std::memory_order_release);
+
+      for (std::size_t phase = 0; phase < 2; ++phase)
+      {
+        std::size_t parity = epoch.fetch_add(1, std::memory_order_relaxed) & 1;
+        for (auto &slot : readers)
+          while (slot.counters[parity].fetch_add(0, std::memory_order_acq_rel) != 0)
+            std::this_thread::yield();
+      }
+      delete old;
+    }
+
+    // each on its own cache line, so readers on different threads don't contend with each other
+    struct alignas(64) reader_counters
+    {
+      std::atomic<std::size_t> counters[2]{};
+    };
+
+    std::atomic<const snapshot *> current{ nullptr };
+    std::atomic<std::size_t> epoch{ 0 };
+    mutable std::array<reader_counters, 16> readers{};
+    std::mutex writer{};
+    std::uint64_t nextKey = 0;
+  };
+
+}
+
+#endif
+#endif
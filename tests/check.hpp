@@ -0,0 +1,21 @@
+// checks for the runtime tests, unlike assert they stay on in release builds and don't stop at the first failure
+#pragma once
+
+#include <cstdio>
+
+namespace test
+{
+  inline int failures = 0;
+
+  // the exit code of a test, 0 if every check passed
+  inline int result()
+  {
+    if (failures != 0)
+      std::fprintf(stderr, "%d checks failed\n", failures);
+    return failures != 0;
+  }
+}
+
+#define CHECK(...)                                                                        \
+  ((__VA_ARGS__) ? (void)0                                                                \
+                 : (void)(++::test::failures, std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #__VA_ARGS__)))
@@ -0,0 +1,155 @@
+// column_view::write and open, a column has to round trip and every header field or section that doesn't fit the
+// bytes it was opened on has to be refused
+#include "nested_enum.hpp"
+#include "check.hpp"
+
+#include <cstdint>
+#include <vector>
+
+NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+  (ENUM, Land, (Car, Bus, Tram))
+)
+
+// Tram was removed and Aircraft moved in front of Watercraft
+namespace v2
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Aircraft, Watercraft),
+    (ENUM, Land, (Car, Bus))
+  )
+}
+
+using Column = nested_enum::column_view<Vehicle>;
+using Codec = nested_enum::tree_codec<Vehicle>;
+using Bytes = std::vector<std::uint8_t>;
+
+struct Record
+{
+  Codec::value_type vehicle;
+  int passengers = 0;
+};
+
+const std::vector<Record> records{
+  { Codec::value(3), 4 }, { Codec::value(5), 120 }, { Codec::value(1), 30 }, { Codec::value(3), 2 }, { Codec::value(2), 200 } };
+
+// header offsets of the version, number of values, bytes per ordinal, number of names and bytes of names
+constexpr std::size_t versionOffset = 8;
+constexpr std::size_t countOffset = 20;
+constexpr std::size_t widthOffset = 28;
+constexpr std::size_t nameCountOffset = 32;
+constexpr std::size_t nameBytesOffset = 40;
+
+Bytes written()
+{
+  Bytes bytes(Column::bytes_needed(records.size()));
+  auto size = Column::write(records, bytes, &Record::vehicle);
+  CHECK(size == bytes.size());
+  return bytes;
+}
+
+// the written column with a header field overwritten
+Bytes patched(std::size_t offset, std::uint64_t value, std::size_t size)
+{
+  auto bytes = written();
+  nested_enum::detail::write_little_endian(value, size, bytes.data() + offset);
+  return bytes;
+}
+
+void check_round_trip()
+{
+  auto bytes = written();
+  auto column = Column::open(bytes);
+  CHECK(column.has_value());
+  if (!column.has_value())
+    return;
+
+  CHECK(column->size() == records.size());
+  CHECK(column->is_current() && column->fingerprint() == Codec::fingerprint);
+  for (std::size_t i = 0; i < records.size(); ++i)
+    CHECK((*column)[i] == records[i].vehicle);
+
+  std::size_t index = 0;
+  for (auto value : *column)
+    CHECK(value == records[index++].vehicle);
+  CHECK(index == records.size());
+
+  // an empty column still has the names
+  Bytes empty(Column::bytes_needed(0));
+  CHECK(Column::write(std::vector<Record>{}, empty, &Record::vehicle) == empty.size());
+  auto emptyColumn = Column::open(empty);
+  CHECK(emptyColumn.has_value() && emptyColumn->empty() && emptyColumn->begin() == emptyColumn->end());
+
+  // not enough space, and values that aren't part of the tree
+  Bytes small(bytes.size() - 1);
+  CHECK(!Column::write(records, small, &Record::vehicle).has_value());
+  auto withNone = records;
+  withNone[2].vehicle = Codec::value_type{};
+  CHECK(!Column::write(withNone, bytes, &Record::vehicle).has_value());
+}
+
+void check_invalid_headers()
+{
+  auto bytes = written();
+
+  // every truncation, down to an empty buffer
+  for (std::size_t size = 0; size < bytes.size(); ++size)
+    CHECK(!Column::open(std::span<const std::uint8_t>(bytes).first(size)).has_value());
+
+  // extra bytes after the column are fine
+  auto longer = bytes;
+  longer.push_back(0);
+  CHECK(Column::open(longer).has_value() && Column::open(longer)->size() == records.size());
+
+  auto badMagic = bytes;
+  badMagic[0] = 'X';
+  CHECK(!Column::open(badMagic).has_value());
+  CHECK(!Column::open(patched(versionOffset, Column::version + 1, 4)).has_value());
+  CHECK(!Column::open(patched(widthOffset, 3, 4)).has_value());
+
+  // counts that go past the end of the bytes, including ones that would overflow when multiplied
+  CHECK(!Column::open(patched(countOffset, records.size() + 1, 8)).has_value());
+  CHECK(!Column::open(patched(countOffset, ~0ull, 8)).has_value());
+  CHECK(!Column::open(patched(widthOffset, 4, 4)).has_value());
+  CHECK(!Column::open(patched(nameBytesOffset, bytes.size(), 8)).has_value());
+  CHECK(!Column::open(patched(nameBytesOffset, ~0ull, 8)).has_value());
+  CHECK(!Column::open(patched(nameCountOffset, bytes.size(), 8)).has_value());
+  CHECK(Column::open(patched(countOffset, records.size() - 1, 8)).has_value());
+
+  // the names have to end in a terminator
+  auto unterminated = bytes;
+  std::size_t nameBytes = (std::size_t)nested_enum::detail::read_little_endian(bytes.data() + nameBytesOffset, 8);
+  unterminated[Column::headerSize + nameBytes - 1] = 'x';
+  CHECK(!Column::open(unterminated).has_value());
+}
+
+// a column written by another version of the tree is read through the names stored in it
+void check_remap()
+{
+  auto bytes = written();
+  auto column = nested_enum::column_view<v2::Vehicle>::open(bytes);
+  CHECK(column.has_value());
+  if (!column.has_value())
+    return;
+
+  using NewCodec = nested_enum::tree_codec<v2::Vehicle>;
+  CHECK(!column->is_current());
+  CHECK((*column)[0].index() == 0);
+
+  std::vector<std::size_t> remap(Codec::size);
+  CHECK(!column->make_remap(std::span<std::size_t>(remap).first(Codec::size - 1)));
+  CHECK(column->make_remap(remap));
+  CHECK(remap == std::vector<std::size_t>{ 0, 2, 1, 3, 4, NewCodec::size });
+  column->use_remap(remap);
+
+  CHECK((*column)[0] == NewCodec::value_type{ v2::Vehicle::Land::Car::value() });
+  CHECK((*column)[1].index() == 0);
+  CHECK((*column)[2] == NewCodec::value_type{ v2::Vehicle::Watercraft::value() });
+  CHECK((*column)[4] == NewCodec::value_type{ v2::Vehicle::Aircraft::value() });
+}
+
+int main()
+{
+  check_round_trip();
+  check_invalid_headers();
+  check_remap();
+  return test::result();
+}
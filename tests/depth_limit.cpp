@@ -0,0 +1,42 @@
+// compiles a tree with 20 levels of nested enums below its root, with NESTED_ENUM_TEST_OVER_LIMIT defined it has 21
+// and has to fail with the static_assert of nested_enum::detail::depth_limit as the only error (see CMakeLists.txt)
+#include "nested_enum.hpp"
+
+#ifndef NESTED_ENUM_TEST_OVER_LIMIT
+#define DEEPEST (ENUM, L20, (Leaf))
+#else
+#define DEEPEST (ENUM, L20, (L21), (ENUM, L21, (Leaf)))
+#endif
+
+NESTED_ENUM((Deep, std::int32_t), (L1),
+  (ENUM, L1, (L2),
+    (ENUM, L2, (L3),
+      (ENUM, L3, (L4),
+        (ENUM, L4, (L5),
+          (ENUM, L5, (L6),
+            (ENUM, L6, (L7),
+              (ENUM, L7, (L8),
+                (ENUM, L8, (L9),
+                  (ENUM, L9, (L10),
+                    (ENUM, L10, (L11),
+                      (ENUM, L11, (L12),
+                        (ENUM, L12, (L13),
+                          (ENUM, L13, (L14),
+                            (ENUM, L14, (L15),
+                              (ENUM, L15, (L16),
+                                (ENUM, L16, (L17),
+                                  (ENUM, L17, (L18),
+                                    (ENUM, L18, (L19),
+                                      (ENUM, L19, (L20),
+                                        DEEPEST
+  )))))))))))))))))))
+)
+
+#ifndef NESTED_ENUM_TEST_OVER_LIMIT
+using Deepest = struct Deep::L1::L2::L3::L4::L5::L6::L7::L8::L9::L10::L11::L12::L13::L14::L15::L16::L17::L18::L19::L20;
+static_assert(Deep::enum_count_recursive() == 21);
+static_assert(Deepest::Leaf == 0);
+static_assert(Deepest::enum_value("Deep::L1::L2::L3::L4::L5::L6::L7::L8::L9::L10::L11::L12::L13::L14::L15::L16::L17::L18::L19::L20::Leaf") == Deepest::Leaf);
+#endif
+
+int main() { }
@@ -0,0 +1,21 @@
+// compiles an enum with the maximum number of entries, with NESTED_ENUM_TEST_OVER_LIMIT defined it has one more
+// and has to fail with the static_assert of nested_enum::detail::entry_limit as the first error (see CMakeLists.txt)
+#include "nested_enum.hpp"
+
+#define ENTRIES_8(prefix) prefix##0, prefix##1, prefix##2, prefix##3, prefix##4, prefix##5, prefix##6, prefix##7
+#define ENTRIES_64(prefix) ENTRIES_8(prefix##0), ENTRIES_8(prefix##1), ENTRIES_8(prefix##2), ENTRIES_8(prefix##3), \
+  ENTRIES_8(prefix##4), ENTRIES_8(prefix##5), ENTRIES_8(prefix##6), ENTRIES_8(prefix##7)
+#define ENTRIES_512(prefix) ENTRIES_64(prefix##0), ENTRIES_64(prefix##1), ENTRIES_64(prefix##2), ENTRIES_64(prefix##3), \
+  ENTRIES_64(prefix##4), ENTRIES_64(prefix##5), ENTRIES_64(prefix##6), ENTRIES_64(prefix##7)
+
+#ifndef NESTED_ENUM_TEST_OVER_LIMIT
+NESTED_ENUM((Limit, std::int32_t), (ENTRIES_512(a), ENTRIES_512(b), ENTRIES_512(c), ENTRIES_512(d)))
+#else
+NESTED_ENUM((Limit, std::int32_t), (ENTRIES_512(a), ENTRIES_512(b), ENTRIES_512(c), ENTRIES_512(d), extra))
+#endif
+
+static_assert(Limit::enumValues.size() == 2048);
+static_assert(Limit::d777 == 2047);
+static_assert(Limit::enum_value("Limit::d777").value() == Limit::d777);
+
+int main() { }
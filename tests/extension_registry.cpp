@@ -0,0 +1,123 @@
+// extension_registry on a single thread, from inside for_each, and with readers that look extensions up while a
+// writer adds and removes them (CMakeLists.txt also builds it with ThreadSanitizer where it's available)
+#include "nested_enum.hpp"
+#include "nested_enum_parallel.hpp"
+#include "check.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+NESTED_ENUM((Vehicle, std::uint32_t, "Category"), (Land, Watercraft),
+  (ENUM, (Land, std::uint64_t), (Motorcycle, Car, Tram, Train),
+    (ENUM, Motorcycle, ((Scooter, ALIAS, "Moped"), Cruiser))
+  )
+)
+
+using Registry = nested_enum::extension_registry<struct Vehicle::Land>;
+
+void check_single_thread()
+{
+  Registry registry;
+  auto funicular = registry.add(Vehicle::Land::Tram, "Funicular");
+  CHECK(funicular.has_value());
+  CHECK(!registry.add(Vehicle::Land::Tram, "Funicular").has_value());
+  CHECK(!registry.add(Vehicle::Land::Value(99), "Funicular").has_value());
+  CHECK(!registry.add(Vehicle::Land::Tram, "").has_value());
+
+  // names of compile-time values and aliases are taken
+  CHECK(!registry.add(Vehicle::Land::Motorcycle, "Scooter").has_value());
+  CHECK(!registry.add(Vehicle::Land::Motorcycle, "Moped").has_value());
+  CHECK(registry.add(Vehicle::Land::Motorcycle, "Chopper").has_value());
+
+  auto found = registry.find("Category::Vehicle::Land::Tram::Funicular");
+  CHECK(found.has_value() && found->parent == Vehicle::Land::Tram && found->key == *funicular);
+  CHECK(!registry.find("Category::Vehicle::Land::Tram::Funiculars").has_value());
+  CHECK(registry.size() == 2);
+
+  CHECK(registry.remove(*funicular));
+  CHECK(!registry.remove(*funicular));
+  CHECK(!registry.find("Category::Vehicle::Land::Tram::Funicular").has_value());
+  CHECK(registry.size() == 1);
+}
+
+// a function passed to for_each can change the registry it iterates, it sees the extensions from before the call
+void check_for_each_writes()
+{
+  Registry registry;
+  registry.add(Vehicle::Land::Train, "Maglev");
+  registry.add(Vehicle::Land::Train, "Monorail");
+
+  std::vector<std::string> seen;
+  registry.for_each(Vehicle::Land::Train, [&](Registry::extension extension, std::string_view fullName, std::string_view name)
+    {
+      seen.emplace_back(name);
+      CHECK(fullName == "Category::Vehicle::Land::Train::" + std::string(name));
+      CHECK(registry.add(Vehicle::Land::Train, std::string(name) + "_copy").has_value());
+      CHECK(registry.remove(extension.key));
+    });
+
+  CHECK(seen == std::vector<std::string>{ "Maglev", "Monorail" });
+  CHECK(registry.size() == 2);
+  CHECK(registry.find("Category::Vehicle::Land::Train::Maglev_copy").has_value());
+  CHECK(!registry.find("Category::Vehicle::Land::Train::Maglev").has_value());
+}
+
+// readers always find the extension that stays, and find the ones that come and go either whole or not at all
+void check_concurrent_readers()
+{
+  constexpr int writes = 400;
+  Registry registry;
+  auto stable = registry.add(Vehicle::Land::Tram, "Funicular");
+
+  std::atomic<bool> stop{ false };
+  std::atomic<int> readerFailures{ 0 };
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < 4; ++reader)
+    readers.emplace_back([&, reader]()
+      {
+        std::size_t iteration = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+          auto found = registry.find("Category::Vehicle::Land::Tram::Funicular");
+          if (!found.has_value() || found->key != *stable)
+            ++readerFailures;
+
+          auto transient = registry.find("Category::Vehicle::Land::Train::T" + std::to_string((iteration++ * 7 + reader) % writes));
+          if (transient.has_value() && transient->parent != Vehicle::Land::Train)
+            ++readerFailures;
+
+          registry.for_each(Vehicle::Land::Train, [&](Registry::extension extension, std::string_view fullName, std::string_view name)
+            {
+              if (extension.parent != Vehicle::Land::Train || name.empty() || !fullName.ends_with(name))
+                ++readerFailures;
+            });
+        }
+      });
+
+  for (int i = 0; i < writes; ++i)
+  {
+    auto key = registry.add(Vehicle::Land::Train, "T" + std::to_string(i));
+    CHECK(key.has_value());
+    if (key.has_value() && i % 2 == 1)
+      CHECK(registry.remove(*key));
+  }
+
+  stop = true;
+  for (auto &reader : readers)
+    reader.join();
+
+  CHECK(readerFailures == 0);
+  CHECK(registry.size() == 1 + writes / 2);
+  CHECK(registry.find("Category::Vehicle::Land::Train::T0").has_value());
+  CHECK(!registry.find("Category::Vehicle::Land::Train::T1").has_value());
+}
+
+int main()
+{
+  check_single_thread();
+  check_for_each_writes();
+  check_concurrent_readers();
+  return test::result();
+}
@@ -0,0 +1,102 @@
+// enums of bit flags, the bits NESTED_ENUM_FLAGS assigns and parsing and formatting of flag_mask
+#include "nested_enum.hpp"
+#include "check.hpp"
+
+#include <array>
+#include <sstream>
+#include <string>
+
+NESTED_ENUM_FLAGS((Letters, std::uint8_t), (A, (AB, VAL, 3), B, C))
+NESTED_ENUM_FLAGS((Permission, std::uint8_t), (Read, Write, Exec, (All, VAL, 7), (Sticky, VAL, 64), (Special, VAL, 48)))
+
+// flags as a node of a tree
+NESTED_ENUM((File, std::uint16_t), (Mode, Size),
+  (FLAGS, (Mode, std::uint16_t), (Hidden, System, (Both, VAL, 3), Archive))
+)
+
+// bits go to the values without a VAL in declaration order, the ones with a VAL are skipped
+static_assert(Letters::A == 1 && Letters::AB == 3 && Letters::B == 2 && Letters::C == 4);
+static_assert(Permission::Read == 1 && Permission::Write == 2 && Permission::Exec == 4 && Permission::All == 7);
+static_assert(File::Mode::Hidden == 1 && File::Mode::System == 2 && File::Mode::Both == 3 && File::Mode::Archive == 4);
+static_assert(nested_enum::flag_mask<Letters>::all == 7);
+static_assert(nested_enum::flag_mask<Permission>::all == 0x77);
+
+using Letter = nested_enum::flag_mask<Letters>;
+using Mask = nested_enum::flag_mask<Permission>;
+
+void check_operators()
+{
+  auto mask = Permission::Read | Permission::Exec;
+  CHECK(mask.bits() == 5);
+  CHECK(mask.contains(Permission::Read) && !mask.contains(Permission::Write) && !mask.contains(Permission::All));
+  CHECK((mask & Permission::All) == mask);
+  CHECK((mask ^ Permission::All) == Mask(Permission::Write));
+  CHECK((~mask).bits() == 0x72);
+  CHECK((Letters::A | Letters::B) == Letter(Letters::AB));
+  CHECK(Mask().empty() && !Mask());
+
+  CHECK(Mask::from_bits(0x77).has_value());
+  CHECK(!Mask::from_bits(0x08).has_value());
+  CHECK(!Mask::from_bits(0x80).has_value());
+  CHECK(!Letter::from_bits(8).has_value());
+}
+
+void check_parse()
+{
+  CHECK(Mask::parse("Read|Exec") == (Permission::Read | Permission::Exec));
+  CHECK(Mask::parse("  Read |\tExec  ") == (Permission::Read | Permission::Exec));
+  CHECK(Mask::parse("Exec|Read|Exec") == (Permission::Read | Permission::Exec));
+  CHECK(Mask::parse("Read, Write", ',') == (Permission::Read | Permission::Write));
+  CHECK(Mask::parse<false>("Permission::Read|Permission::Write") == (Permission::Read | Permission::Write));
+  // composite values are found by their names as well
+  CHECK(Mask::parse("All|Sticky") == Mask::from_bits(0x47));
+  CHECK(Letter::parse("AB") == (Letters::A | Letters::B));
+  CHECK(nested_enum::flag_mask<struct File::Mode>::parse("Both|Archive") == (File::Mode::Both | File::Mode::Archive));
+  CHECK(nested_enum::flag_mask<struct File::Mode>::parse<false>("File::Mode::Hidden") == File::Mode::Hidden);
+
+  // only whitespace is an empty mask
+  CHECK(Mask::parse("") == Mask());
+  CHECK(Mask::parse("  \t") == Mask());
+
+  // empty names between separators and names that aren't part of the enum
+  CHECK(!Mask::parse("Read||Exec").has_value());
+  CHECK(!Mask::parse("Read|").has_value());
+  CHECK(!Mask::parse("|Read").has_value());
+  CHECK(!Mask::parse("Read| |Exec").has_value());
+  CHECK(!Mask::parse("Read|Run").has_value());
+  CHECK(!Mask::parse("Re ad").has_value());
+  CHECK(!Mask::parse("Permission::Read").has_value());
+  CHECK(!Mask::parse<false>("Read").has_value());
+}
+
+void check_format()
+{
+  std::array<char, Mask::max_formatted_size()> buffer{};
+  static_assert(Mask::max_formatted_size() == std::string_view("Read|Write|Exec|Sticky").size());
+
+  CHECK((Permission::Read | Permission::Exec).format(buffer) == "Read|Exec");
+  CHECK(Mask(Permission::All).format(buffer, ',') == "Read,Write,Exec");
+  CHECK(Mask::from_bits(0x47).has_value() && Mask::from_bits(0x47)->format(buffer) == "Read|Write|Exec|Sticky");
+  CHECK(Mask().format(buffer) == "");
+
+  std::array<char, Mask::max_formatted_size<false>()> longBuffer{};
+  CHECK((Permission::Read | Permission::Exec).format<false>(longBuffer) == "Permission::Read|Permission::Exec");
+
+  // too small a buffer, and bits that no single value has
+  CHECK(!(Permission::Read | Permission::Exec).format(std::span<char>(buffer).first(8)).has_value());
+  CHECK((Permission::Read | Permission::Exec).format(std::span<char>(buffer).first(9)) == "Read|Exec");
+  CHECK(!Mask(Permission::Special).format(buffer).has_value());
+
+  // streams write those bits as an integer
+  std::ostringstream stream;
+  stream << (Permission::Write | Permission::Special) << ' ' << Mask() << ' ' << Mask(Permission::Exec);
+  CHECK(stream.str() == "Write|48  Exec");
+}
+
+int main()
+{
+  check_operators();
+  check_parse();
+  check_format();
+  return test::result();
+}
@@ -0,0 +1,113 @@
+// the std::formatter specializations of enums and of tree_codec<E>::value_type, CMakeLists.txt only builds this where
+// <format> is available, once as it is and once with NESTED_ENUM_NO_NAMES defined
+#include "nested_enum.hpp"
+#include "check.hpp"
+
+#include <format>
+#include <string>
+#include <string_view>
+
+NESTED_ENUM((Vehicle, std::uint32_t, "Category"), (Land, Watercraft),
+  (ENUM, (Land, std::uint64_t), (Motorcycle, Car, Tram),
+    (),
+    (ENUM, Car, ((Minicompact, VAL_ID, 10, "A-segment"), (Subcompact, VAL, 20)))
+  )
+)
+
+using Codec = nested_enum::tree_codec<Vehicle>;
+
+// the spec is only known at runtime, so that the errors can be caught
+template<typename ... Args>
+bool throws(std::string_view spec, const Args &... args)
+{
+  try
+  {
+    (void)std::vformat(spec, std::make_format_args(args...));
+  }
+  catch (const std::format_error &)
+  {
+    return true;
+  }
+  return false;
+}
+
+void check_types()
+{
+  auto minicompact = Vehicle::Land::Car::Minicompact::value();
+  auto subcompact = Vehicle::Land::Car::Subcompact::value();
+
+#ifndef NESTED_ENUM_NO_NAMES
+  CHECK(std::format("{}", minicompact) == "Category::Vehicle::Land::Car::Minicompact");
+  CHECK(std::format("{:n}", minicompact) == "Category::Vehicle::Land::Car::Minicompact");
+  CHECK(std::format("{:c}", minicompact) == "Minicompact");
+  CHECK(std::format("{:>13c}", minicompact) == "  Minicompact");
+  CHECK(std::format("{:*<8.4c}", minicompact) == "Mini****");
+#else
+  CHECK(std::format("{}", minicompact) == "10");
+  CHECK(throws("{:n}", minicompact));
+  CHECK(throws("{:c}", minicompact));
+#endif
+
+  CHECK(std::format("{:i}", minicompact) == "A-segment");
+  CHECK(std::format("{:>3i}", subcompact) == "   ");
+  CHECK(std::format("{:d}", minicompact) == "10");
+  CHECK(std::format("{:+05d}", subcompact) == "+0020");
+
+  CHECK(throws("{:x}", minicompact));
+  CHECK(throws("{:5.d}", minicompact));
+  CHECK(throws("{:#i}", minicompact));
+}
+
+// widths and precisions from other arguments, with automatic and manual argument ids
+void check_dynamic_width()
+{
+  auto minicompact = Vehicle::Land::Car::Minicompact::value();
+  int width = 4;
+  int precision = 2;
+
+  CHECK(std::format("{:>{}d}", minicompact, width) == "  10");
+  CHECK(std::format("{:{}d}|{}", minicompact, width, 7) == "  10|7");
+  CHECK(std::format("{1:>{0}d}|{0}", width, minicompact) == "  10|4");
+  CHECK(std::format("{:{}.{}i}", minicompact, width, precision) == "A-  ");
+#ifndef NESTED_ENUM_NO_NAMES
+  CHECK(std::format("{:<{}.{}c}|", minicompact, 6, precision) == "Mi    |");
+#endif
+
+  // the argument has to be an integer and has to exist, automatic and manual ids can't be mixed
+  CHECK(throws("{:>{}d}", minicompact, "x"));
+  CHECK(throws("{:>{}d}", minicompact, minicompact));
+  CHECK(throws("{:>{2}d}", minicompact, width));
+  CHECK(throws("{:>{}d}", minicompact));
+  CHECK(throws("{:>{1}d}{}", minicompact, width));
+  CHECK(throws("{:>{d}", minicompact, width));
+}
+
+// every alternative of the variant is formatted with the same spec, std::monostate is an empty string that only specs
+// of names and ids pad
+void check_variant()
+{
+  Codec::value_type none{};
+  Codec::value_type tram = Codec::value(Codec::ordinal(Vehicle::Land::Tram).value());
+  Codec::value_type watercraft = Codec::value(Codec::ordinal(Vehicle::Watercraft).value());
+
+  CHECK(std::format("[{}]", none) == "[]");
+  CHECK(std::format("[{:>4d}]", none) == "[]");
+  CHECK(std::format("{:d}", tram) == "2");
+  CHECK(std::format("{:>3d}", watercraft) == "  1");
+#ifndef NESTED_ENUM_NO_NAMES
+  CHECK(std::format("[{:>4}]", none) == "[    ]");
+  CHECK(std::format("{}", tram) == "Category::Vehicle::Land::Tram");
+  CHECK(std::format("{:c}", watercraft) == "Watercraft");
+#else
+  CHECK(std::format("{}", tram) == "2");
+  CHECK(throws("{:c}", watercraft));
+#endif
+}
+
+int main()
+{
+  check_types();
+  check_dynamic_width();
+  check_variant();
+  return test::result();
+}
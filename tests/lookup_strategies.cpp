@@ -0,0 +1,115 @@
+// every lookup strategy has to find the same position as the linear one, for names, aliases, ids and for strings
+// that miss, including ones of the same length as a name that only differ in a single character
+#include "nested_enum.hpp"
+#include "check.hpp"
+
+#include <string>
+#include <vector>
+
+#define ENTRIES_8(macro, prefix) macro(prefix##0) macro(prefix##1) macro(prefix##2) macro(prefix##3) \
+  macro(prefix##4) macro(prefix##5) macro(prefix##6) macro(prefix##7)
+#define ENTRY_WITH_ID(name) (name, ID, #name),
+
+// below the default crossover, names of the same length and repeated ids
+NESTED_ENUM((Shade, std::uint8_t), ((Red, ID_ALIAS, "r", "Crimson"), (Rex, ID, "x"), (Reg, ID_ALIAS, "r", "Ruby"), Rad,
+  (Blue, ALIAS, "Navy"), (Blur, ID, "bb")))
+// decision tree by default
+NESTED_ENUM((Medium, std::uint16_t), (ENTRIES_8(ENTRY_WITH_ID, a) ENTRIES_8(ENTRY_WITH_ID, b) ENTRIES_8(ENTRY_WITH_ID, c)
+  (long_name, ALIAS, "old_long_name"), (long_nane, ID, "a0")))
+// hash table by default
+NESTED_ENUM((Large, std::uint16_t), (ENTRIES_8(ENTRY_WITH_ID, a) ENTRIES_8(ENTRY_WITH_ID, b) ENTRIES_8(ENTRY_WITH_ID, c)
+  ENTRIES_8(ENTRY_WITH_ID, d) ENTRIES_8(ENTRY_WITH_ID, e) ENTRIES_8(ENTRY_WITH_ID, f) ENTRIES_8(ENTRY_WITH_ID, g)
+  ENTRIES_8(ENTRY_WITH_ID, h) ENTRIES_8(ENTRY_WITH_ID, i) (Alpha, ALIAS, "Beta")))
+
+using nested_enum::lookup_strategy;
+
+static_assert(nested_enum::enum_lookup_strategy<struct Shade> == lookup_strategy::linear);
+static_assert(nested_enum::enum_lookup_strategy<struct Medium> == lookup_strategy::decision_tree);
+static_assert(nested_enum::enum_lookup_strategy<struct Large> == lookup_strategy::hash);
+
+// the strings themselves, every one with a single character changed, one character more and one less
+template<typename Strings>
+std::vector<std::string> with_near_misses(const Strings &strings)
+{
+  std::vector<std::string> result;
+  for (const auto &string : strings)
+  {
+    if (!string.has_value())
+      continue;
+
+    std::string original{ *string };
+    result.push_back(original);
+    for (std::size_t i = 0; i < original.size(); ++i)
+    {
+      std::string changed = original;
+      changed[i] = (char)(changed[i] ^ 1);
+      result.push_back(changed);
+    }
+    result.push_back(original + "x");
+    if (!original.empty())
+      result.push_back(original.substr(0, original.size() - 1));
+  }
+  result.push_back("");
+  return result;
+}
+
+template<typename E, bool byId>
+void check_strategies(const std::vector<std::string> &inputs)
+{
+  for (const auto &input : inputs)
+  {
+    std::size_t expected = nested_enum::detail::find_string<E, byId, lookup_strategy::linear>(input);
+    CHECK(nested_enum::detail::find_string<E, byId, lookup_strategy::hash>(input) == expected);
+    CHECK(nested_enum::detail::find_string<E, byId, lookup_strategy::decision_tree>(input) == expected);
+    CHECK(nested_enum::detail::find_string<E, byId>(input) == expected);
+  }
+}
+
+template<typename E>
+void check_enum()
+{
+  std::vector<std::optional<std::string_view>> names, ids, cleanNames;
+  for (auto name : E::enum_names())
+    names.emplace_back(name);
+  for (auto name : E::enum_names(true))
+    cleanNames.emplace_back(name);
+  for (auto alias : nested_enum::detail::aliasStrings<E, false>)
+    names.emplace_back(alias);
+  for (auto id : E::enumIds)
+    ids.push_back(id);
+
+  // the linear lookup is what the other ones are checked against, so it's checked on its own first
+  for (std::size_t i = 0; i < E::enumValues.size(); ++i)
+    CHECK(nested_enum::detail::find_string<E, false, lookup_strategy::linear>(*names[i]) == i);
+  for (std::size_t i = 0; i < nested_enum::detail::aliasCount<E>; ++i)
+    CHECK(nested_enum::detail::find_string<E, false, lookup_strategy::linear>(nested_enum::detail::aliasStrings<E, false>[i]) ==
+      nested_enum::detail::aliasNames<E>.positions[i]);
+
+  // names, aliases and clean names (which are misses) by name, ids by id and the other way around
+  auto nameInputs = with_near_misses(names);
+  auto cleanInputs = with_near_misses(cleanNames);
+  auto idInputs = with_near_misses(ids);
+  nameInputs.insert(nameInputs.end(), cleanInputs.begin(), cleanInputs.end());
+  check_strategies<E, false>(nameInputs);
+  check_strategies<E, false>(idInputs);
+  check_strategies<E, true>(idInputs);
+  check_strategies<E, true>(nameInputs);
+}
+
+int main()
+{
+  check_enum<struct Shade>();
+  check_enum<struct Medium>();
+  check_enum<struct Large>();
+
+  // repeated ids resolve to the first value that has them
+  CHECK(Shade::enum_value_by_id("r") == Shade::Red);
+  CHECK(nested_enum::detail::find_string<struct Shade, true, lookup_strategy::decision_tree>("r") == 0);
+  CHECK(nested_enum::detail::find_string<struct Shade, true, lookup_strategy::hash>("r") == 0);
+  CHECK(Medium::enum_value_by_id("a0") == Medium::a0);
+  CHECK(Shade::enum_value("Shade::Ruby") == Shade::Reg);
+  CHECK(!Shade::enum_value("Shade::Rub").has_value());
+  CHECK(Large::enum_value("Large::Beta") == Large::Alpha);
+
+  return test::result();
+}
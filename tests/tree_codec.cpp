@@ -0,0 +1,132 @@
+// tree_codec encoding and decoding of single values and of spans of them, including buffers that end too early,
+// ordinals past the end of the tree and varints that aren't the shortest encoding of their value
+#include "nested_enum.hpp"
+#include "check.hpp"
+
+#include <array>
+#include <vector>
+
+#define ENTRIES_8(prefix) prefix##0, prefix##1, prefix##2, prefix##3, prefix##4, prefix##5, prefix##6, prefix##7
+#define ENTRIES_64(prefix) ENTRIES_8(prefix##0), ENTRIES_8(prefix##1), ENTRIES_8(prefix##2), ENTRIES_8(prefix##3), \
+  ENTRIES_8(prefix##4), ENTRIES_8(prefix##5), ENTRIES_8(prefix##6), ENTRIES_8(prefix##7)
+
+// more than 128 values, so the last ordinals take two bytes
+NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+  (ENUM, Land, (Car, Bus),
+    (),
+    (ENUM, Bus, (Shuttle, Coach))
+  ),
+  (),
+  (ENUM, Aircraft, (ENTRIES_64(a), ENTRIES_64(b), ENTRIES_8(c)))
+)
+
+using Codec = nested_enum::tree_codec<Vehicle>;
+using Bytes = std::vector<std::uint8_t>;
+
+static_assert(Codec::size == 3 + 2 + 2 + 136);
+static_assert(Codec::maxEncodedSize == 2);
+
+// decodes bytes that were built by hand
+auto decode(const Bytes &bytes) { return Codec::decode(std::span<const std::uint8_t>(bytes)); }
+
+void check_single_values()
+{
+  for (std::size_t i = 0; i < Codec::size; ++i)
+  {
+    std::array<std::uint8_t, Codec::maxEncodedSize> buffer{};
+    std::size_t bytes = Codec::encode(Codec::value(i), buffer);
+    CHECK(bytes == (i < 128 ? 1u : 2u));
+
+    auto [value, read] = Codec::decode(buffer);
+    CHECK(read == bytes);
+    CHECK(Codec::ordinal(value) == i);
+  }
+
+  // every kind of value encodes the same
+  std::array<std::uint8_t, 2> buffer{};
+  CHECK(Codec::encode(Vehicle::Land::Bus::Coach, buffer) == 1 && buffer[0] == 6);
+  CHECK(Codec::encode(Vehicle::Land::Bus::Coach::value(), buffer) == 1 && buffer[0] == 6);
+  CHECK(Codec::encode(Codec::value(6), buffer) == 1 && buffer[0] == 6);
+  CHECK(Codec::encode(Vehicle::Aircraft::c7, buffer) == 2 && buffer[0] == 0x8e && buffer[1] == 1);
+
+  // values that aren't part of the tree and buffers without enough space
+  CHECK(Codec::encode(Codec::value_type{}, buffer) == 0);
+  CHECK(Codec::encode(Vehicle::Land::Value(9), buffer) == 0);
+  CHECK(Codec::encode(Vehicle::Land::Car, std::span<std::uint8_t>()) == 0);
+  CHECK(Codec::encode(Vehicle::Aircraft::c7, std::span<std::uint8_t>(buffer).first(1)) == 0);
+}
+
+void check_invalid_bytes()
+{
+  auto invalid = [](const Bytes &bytes)
+  {
+    auto [value, read] = decode(bytes);
+    return read == 0 && value.index() == 0;
+  };
+
+  // truncated
+  CHECK(invalid({}));
+  CHECK(invalid({ 0x8e }));
+  // ordinals past the end of the tree
+  CHECK(invalid({ (std::uint8_t)Codec::size }));
+  CHECK(invalid({ 0xff, 0x7f }));
+  CHECK(invalid({ 0x80, 0x80, 0x01 }));
+  // overlong encodings of 0 and 14
+  CHECK(invalid({ 0x80, 0x00 }));
+  CHECK(invalid({ 0x8e, 0x00 }));
+
+  // only the start of the buffer is read
+  CHECK(decode({ 0x8e, 0x01, 0xff }).second == 2);
+  CHECK(Codec::ordinal(decode({ 0x00, 0x80 }).first) == 0u);
+
+  // the shortest encoding of every 64 bit value is read, anything longer or past 64 bits isn't
+  auto read = [](const Bytes &bytes) { return nested_enum::detail::read_varint(bytes); };
+  CHECK(read({ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 }) == std::pair<std::uint64_t, std::size_t>{ ~0ull, 10 });
+  CHECK(read({ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02 }).second == 0);
+  CHECK(read({ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 }).second == 0);
+  CHECK(read({ 0xff, 0x80, 0x00 }).second == 0);
+}
+
+void check_spans()
+{
+  std::vector<Codec::value_type> values;
+  for (std::size_t i = 0; i < Codec::size; i += 5)
+    values.push_back(Codec::value(i));
+
+  std::vector<std::uint8_t> buffer(values.size() * Codec::maxEncodedSize);
+  auto bytes = Codec::encode(values, buffer);
+  CHECK(bytes.has_value());
+  buffer.resize(bytes.value_or(0));
+
+  std::vector<Codec::value_type> decoded(values.size());
+  CHECK(Codec::decode(buffer, decoded) == values.size());
+  CHECK(decoded == values);
+
+  // not enough space on either side
+  std::vector<std::uint8_t> shortBuffer(buffer.size() - 1);
+  CHECK(!Codec::encode(values, shortBuffer).has_value());
+  decoded.pop_back();
+  CHECK(!Codec::decode(buffer, decoded).has_value());
+
+  // a value that isn't part of the tree
+  auto withNone = values;
+  withNone[1] = Codec::value_type{};
+  std::vector<std::uint8_t> unused(buffer.size());
+  CHECK(!Codec::encode(withNone, unused).has_value());
+
+  // truncated, out of range or overlong values anywhere in the buffer
+  decoded.resize(values.size() + 1);
+  CHECK(Codec::decode(std::span<const std::uint8_t>(), decoded) == 0u);
+  CHECK(!Codec::decode(Bytes{ 0x01, 0x8e }, decoded).has_value());
+  CHECK(!Codec::decode(Bytes{ 0x01, (std::uint8_t)Codec::size, 0x02 }, decoded).has_value());
+  CHECK(!Codec::decode(Bytes{ 0x01, 0x81, 0x00, 0x02 }, decoded).has_value());
+  CHECK(Codec::decode(Bytes{ 0x01, 0x8e, 0x01, 0x02 }, decoded) == 3u);
+}
+
+int main()
+{
+  check_single_values();
+  check_invalid_bytes();
+  check_spans();
+  return test::result();
+}
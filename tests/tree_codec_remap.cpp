@@ -0,0 +1,121 @@
+// tree_codec::make_remap and decode_remapped between two versions of a tree, and the fingerprint that tells versions
+// apart, every version is the same Vehicle tree in its own namespace
+#include "nested_enum.hpp"
+#include "check.hpp"
+
+#include <array>
+#include <vector>
+
+namespace v1
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (ENUM, Land, (Car, Bus, Tram))
+  )
+}
+
+// Watercraft and Aircraft swapped places, Car was renamed (and keeps its old name as an alias) and Tram was removed
+namespace v2
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Aircraft, Watercraft),
+    (ENUM, Land, ((Automobile, ALIAS, "Car"), Bus))
+  )
+}
+
+// the same as v1
+namespace same
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (ENUM, Land, (Car, Bus, Tram))
+  )
+}
+
+// v1 with a single change each
+namespace renamed
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (ENUM, Land, (Car, Bus, Trolley))
+  )
+}
+
+namespace revalued
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (ENUM, Land, (Car, Bus, (Tram, VAL, 7)))
+  )
+}
+
+namespace reidentified
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (ENUM, Land, (Car, Bus, (Tram, ID, "T")))
+  )
+}
+
+namespace retyped
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (ENUM, (Land, std::uint64_t), (Car, Bus, Tram))
+  )
+}
+
+// Car, Bus and Tram are the same values in another shape, Land has no subtypes and Watercraft has them instead
+namespace reshaped
+{
+  NESTED_ENUM((Vehicle, std::uint32_t), (Land, Watercraft, Aircraft),
+    (),
+    (ENUM, Watercraft, (Car, Bus, Tram))
+  )
+}
+
+using Old = nested_enum::tree_codec<v1::Vehicle>;
+using New = nested_enum::tree_codec<v2::Vehicle>;
+
+static_assert(Old::fingerprint == nested_enum::tree_codec<same::Vehicle>::fingerprint);
+static_assert(Old::fingerprint != New::fingerprint);
+static_assert(Old::fingerprint != nested_enum::tree_codec<renamed::Vehicle>::fingerprint);
+static_assert(Old::fingerprint != nested_enum::tree_codec<revalued::Vehicle>::fingerprint);
+static_assert(Old::fingerprint != nested_enum::tree_codec<reidentified::Vehicle>::fingerprint);
+static_assert(Old::fingerprint != nested_enum::tree_codec<retyped::Vehicle>::fingerprint);
+static_assert(Old::fingerprint != nested_enum::tree_codec<reshaped::Vehicle>::fingerprint);
+
+void check_remap()
+{
+  constexpr auto oldNames = v1::Vehicle::enum_names_recursive<nested_enum::All>();
+  static_assert(oldNames.size() == Old::size);
+
+  std::array<std::size_t, Old::size> remap{};
+  CHECK(New::make_remap(oldNames, remap));
+  CHECK(remap == std::array<std::size_t, Old::size>{ 0, 2, 1, 3, 4, New::size });
+  CHECK(!New::make_remap(oldNames, std::span<std::size_t>(remap).first(Old::size - 1)));
+
+  // every old value decodes to the value with the same name (or alias) in the new version, or to nothing
+  for (std::size_t i = 0; i < Old::size; ++i)
+  {
+    std::array<std::uint8_t, Old::maxEncodedSize> buffer{};
+    std::size_t bytes = Old::encode(Old::value(i), buffer);
+    CHECK(bytes == 1);
+
+    auto [value, read] = New::decode_remapped(buffer, remap);
+    if (remap[i] == New::size)
+      CHECK(read == 0 && value.index() == 0);
+    else
+      CHECK(read == bytes && New::ordinal(value) == remap[i]);
+  }
+
+  std::array<std::uint8_t, 1> buffer{};
+  Old::encode(v1::Vehicle::Land::Car, buffer);
+  CHECK(New::decode_remapped(buffer, remap).first == New::value_type{ v2::Vehicle::Land::Automobile::value() });
+  Old::encode(v1::Vehicle::Aircraft, buffer);
+  CHECK(New::decode_remapped(buffer, remap).first == New::value_type{ v2::Vehicle::Aircraft::value() });
+
+  // ordinals past the end of the old version and varints that don't end or are overlong
+  CHECK(New::decode_remapped(std::array<std::uint8_t, 1>{ (std::uint8_t)Old::size }, remap).second == 0);
+  CHECK(New::decode_remapped(std::array<std::uint8_t, 1>{ 0x81 }, remap).second == 0);
+  CHECK(New::decode_remapped(std::array<std::uint8_t, 2>{ 0x81, 0x00 }, remap).second == 0);
+}
+
+int main()
+{
+  check_remap();
+  return test::result();
+}